@@ -29,11 +29,16 @@
 #include "bricklib2/warp/rs485.h"
 
 #include "io.h"
+#include "latency.h"
 #include "voltage.h"
 #include "eeprom.h"
 #include "sd.h"
+#include "sd_queue.h"
+#include "sd_statistics.h"
+#include "sd_query.h"
 #include "sdmmc.h"
 #include "data_storage.h"
+#include "data_storage_flush.h"
 #include "eeprom.h"
 
 #include "xmc_rtc.h"
@@ -41,7 +46,7 @@
 // SD lfs format bool is outside of struct to avoid it being overwritten during re-init of SD card
 extern bool sd_lfs_format;
 
-static uint8_t get_sd_lfs_status(const uint8_t end, const uint8_t max_length) {
+static uint8_t get_sd_lfs_status(const bool queue_full) {
 	if(sd.sd_status != SDMMC_ERROR_OK) {
 		return WARP_ENERGY_MANAGER_V2_DATA_STATUS_SD_ERROR;
 	}
@@ -50,13 +55,22 @@ static uint8_t get_sd_lfs_status(const uint8_t end, const uint8_t max_length) {
 		return WARP_ENERGY_MANAGER_V2_DATA_STATUS_LFS_ERROR;
 	}
 
-	if(end >= max_length) {
+	if(queue_full) {
 		return WARP_ENERGY_MANAGER_V2_DATA_STATUS_QUEUE_FULL;
 	}
 
 	return WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK;
 }
 
+static uint8_t get_sd_queue_add_status(const SDQueueType type) {
+	const uint8_t status = get_sd_lfs_status(sd_queue_get_free(type) == 0);
+	if(status == WARP_ENERGY_MANAGER_V2_DATA_STATUS_QUEUE_FULL) {
+		sd_statistics_queue_full(type);
+	}
+
+	return status;
+}
+
 static uint8_t get_date_status(uint8_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t minute) {
 	// Year: Accept all years
 
@@ -99,6 +113,173 @@ static uint8_t get_amount_daily_status(uint8_t day, uint16_t amount) {
 	return WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK;
 }
 
+static uint8_t add_sd_wallbox_data_point(const SetSDWallboxDataPoint *data) {
+	uint8_t status = get_sd_queue_add_status(SD_QUEUE_WALLBOX_DATA_POINT);
+	if(status != WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK) {
+		return status;
+	}
+	status = get_date_status(data->year, data->month, data->day, data->hour, data->minute);
+	if(status != WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK) {
+		return status;
+	}
+
+	sd_queue_add(SD_QUEUE_WALLBOX_DATA_POINT, &data->wallbox_id);
+
+	return WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK;
+}
+
+static uint8_t add_sd_energy_manager_data_point(const SetSDEnergyManagerDataPoint *data) {
+	uint8_t status = get_sd_queue_add_status(SD_QUEUE_ENERGY_MANAGER_DATA_POINT);
+	if(status != WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK) {
+		return status;
+	}
+	status = get_date_status(data->year, data->month, data->day, data->hour, data->minute);
+	if(status != WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK) {
+		return status;
+	}
+
+	sd_queue_add(SD_QUEUE_ENERGY_MANAGER_DATA_POINT, &data->year);
+
+	return WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK;
+}
+
+static uint8_t add_sd_wallbox_daily_data_point(const SetSDWallboxDailyDataPoint *data) {
+	uint8_t status = get_sd_queue_add_status(SD_QUEUE_WALLBOX_DAILY_DATA_POINT);
+	if(status != WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK) {
+		return status;
+	}
+	status = get_date_status(data->year, data->month, data->day, 0, 0);
+	if(status != WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK) {
+		return status;
+	}
+
+	sd_queue_add(SD_QUEUE_WALLBOX_DAILY_DATA_POINT, &data->wallbox_id);
+
+	return WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK;
+}
+
+static uint8_t add_sd_energy_manager_daily_data_point(const SetSDEnergyManagerDailyDataPoint *data) {
+	uint8_t status = get_sd_queue_add_status(SD_QUEUE_ENERGY_MANAGER_DAILY_DATA_POINT);
+	if(status != WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK) {
+		return status;
+	}
+	status = get_date_status(data->year, data->month, data->day, 0, 0);
+	if(status != WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK) {
+		return status;
+	}
+
+	sd_queue_add(SD_QUEUE_ENERGY_MANAGER_DAILY_DATA_POINT, &data->year);
+
+	return WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK;
+}
+
+// The batched data point functions transport a stream of packed data points
+// (the payload of the corresponding single data point function without TFP header).
+// A data point can be split over two chunks. If a data point is not accepted
+// the stream is stopped and the host starts a new stream (chunk offset 0)
+// with the first data point that was not accepted.
+typedef struct {
+	uint16_t chunk_offset;
+	uint16_t data_points_accepted;
+	uint8_t data_point_offset;
+	bool in_sync;
+} DataPointStream;
+
+static DataPointStream sd_wallbox_data_point_stream;
+static SetSDWallboxDataPoint sd_wallbox_data_point_stream_data_point;
+
+static DataPointStream sd_energy_manager_data_point_stream;
+static SetSDEnergyManagerDataPoint sd_energy_manager_data_point_stream_data_point;
+
+static DataPointStream sd_wallbox_daily_data_point_stream;
+static SetSDWallboxDailyDataPoint sd_wallbox_daily_data_point_stream_data_point;
+
+static DataPointStream sd_energy_manager_daily_data_point_stream;
+static SetSDEnergyManagerDailyDataPoint sd_energy_manager_daily_data_point_stream_data_point;
+
+// The data storage pages are streamed in order, starting with page 0.
+// Get and set use the same 64 byte record, the status is ignored on set.
+typedef struct {
+	TFPMessageHeader header;
+	uint8_t status;
+	uint8_t data[63];
+} __attribute__((__packed__)) DataStoragePage;
+
+static DataPointStream data_storage_page_stream;
+static DataStoragePage data_storage_page_stream_page;
+
+static uint8_t handle_data_point_stream(DataPointStream *stream, void *data_point, const uint8_t data_point_length, uint8_t (*add_data_point)(const void *data_point), const uint16_t data_length, const uint16_t chunk_offset, const uint8_t *chunk_data, const uint8_t chunk_length) {
+	if(chunk_offset == 0) {
+		stream->chunk_offset         = 0;
+		stream->data_points_accepted = 0;
+		stream->data_point_offset    = 0;
+		stream->in_sync              = true;
+	}
+
+	if(!stream->in_sync || (chunk_offset != stream->chunk_offset) || (chunk_offset > data_length)) {
+		stream->in_sync = false;
+		return WARP_ENERGY_MANAGER_V2_DATA_STATUS_STREAM_OUT_OF_SYNC;
+	}
+
+	uint8_t *data_point_data = ((uint8_t*)data_point) + sizeof(TFPMessageHeader);
+	const uint16_t length = MIN(chunk_length, data_length - chunk_offset);
+	for(uint16_t i = 0; i < length; i++) {
+		data_point_data[stream->data_point_offset] = chunk_data[i];
+		stream->data_point_offset++;
+
+		if(stream->data_point_offset == data_point_length) {
+			stream->data_point_offset = 0;
+
+			const uint8_t status = add_data_point(data_point);
+			if(status != WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK) {
+				stream->in_sync = false;
+				return status;
+			}
+			stream->data_points_accepted++;
+		}
+	}
+
+	stream->chunk_offset += length;
+
+	return WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK;
+}
+
+static uint8_t add_sd_wallbox_data_point_from_stream(const void *data_point) {
+	return add_sd_wallbox_data_point(data_point);
+}
+
+static uint8_t add_sd_energy_manager_data_point_from_stream(const void *data_point) {
+	return add_sd_energy_manager_data_point(data_point);
+}
+
+static uint8_t add_sd_wallbox_daily_data_point_from_stream(const void *data_point) {
+	return add_sd_wallbox_daily_data_point(data_point);
+}
+
+static uint8_t add_sd_energy_manager_daily_data_point_from_stream(const void *data_point) {
+	return add_sd_energy_manager_daily_data_point(data_point);
+}
+
+static void write_data_storage_page(const uint8_t page, const uint8_t *data) {
+	// Copy data into storage and set new change time.
+	// Data will be copied from RAM to SD after 10 minutes
+	// or after the delay set with set_data_storage_flush_delay.
+	if(!data_storage.has_been_written_once[page] || (memcmp(data_storage.storage[page], data, 63) != 0)) {
+		data_storage.file_not_found[page] = false;
+		memcpy(data_storage.storage[page], data, 63);
+		if(data_storage.last_change_time[page] == 0) {
+			data_storage.last_change_time[page] = system_timer_get_ms();
+		}
+	}
+}
+
+static uint8_t add_data_storage_page_from_stream(const void *data_point) {
+	const DataStoragePage *page = data_point;
+	write_data_storage_page((uint8_t)data_storage_page_stream.data_points_accepted, page->data);
+
+	return WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK;
+}
+
 
 BootloaderHandleMessageResponse handle_message(const void *message, void *response) {
 	const uint8_t length = ((TFPMessageHeader*)message)->length;
@@ -129,6 +310,22 @@ BootloaderHandleMessageResponse handle_message(const void *message, void *respon
 		case FID_GET_DATA_STORAGE:                           return length != sizeof(GetDataStorage)                       ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : get_data_storage(message, response);
 		case FID_SET_DATA_STORAGE:                           return length != sizeof(SetDataStorage)                       ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : set_data_storage(message);
 		case FID_RESET_ENERGY_METER_RELATIVE_ENERGY:         return length != sizeof(ResetEnergyMeterRelativeEnergy)       ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : reset_energy_meter_relative_energy(message);
+		case FID_SET_SD_WALLBOX_DATA_POINTS_LOW_LEVEL:       return length != sizeof(SetSDWallboxDataPointsLowLevel)       ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : set_sd_wallbox_data_points_low_level(message, response);
+		case FID_SET_SD_ENERGY_MANAGER_DATA_POINTS_LOW_LEVEL: return length != sizeof(SetSDEnergyManagerDataPointsLowLevel) ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : set_sd_energy_manager_data_points_low_level(message, response);
+		case FID_GET_SD_QUEUE_STATUS:                        return length != sizeof(GetSDQueueStatus)                     ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : get_sd_queue_status(message, response);
+		case FID_GET_MAIN_LOOP_LATENCY:                      return length != sizeof(GetMainLoopLatency)                   ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : get_main_loop_latency(message, response);
+		case FID_GET_SD_DATA_POINTS_RANGE:                   return length != sizeof(GetSDDataPointsRange)                 ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : get_sd_data_points_range(message, response);
+		case FID_GET_SD_ENERGY_MANAGER_DATA_POINTS_AGGREGATED: return length != sizeof(GetSDEnergyManagerDataPointsAggregated) ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : get_sd_energy_manager_data_points_aggregated(message, response);
+		case FID_GET_SD_DATA_POINTS_EXPORT:                  return length != sizeof(GetSDDataPointsExport)                ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : get_sd_data_points_export(message, response);
+		case FID_SET_SD_WALLBOX_DAILY_DATA_POINTS_LOW_LEVEL: return length != sizeof(SetSDWallboxDailyDataPointsLowLevel)  ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : set_sd_wallbox_daily_data_points_low_level(message, response);
+		case FID_SET_SD_ENERGY_MANAGER_DAILY_DATA_POINTS_LOW_LEVEL: return length != sizeof(SetSDEnergyManagerDailyDataPointsLowLevel) ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : set_sd_energy_manager_daily_data_points_low_level(message, response);
+		case FID_SET_DATA_STORAGE_FLUSH_DELAY:               return length != sizeof(SetDataStorageFlushDelay)             ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : set_data_storage_flush_delay(message);
+		case FID_GET_DATA_STORAGE_FLUSH_DELAY:               return length != sizeof(GetDataStorageFlushDelay)             ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : get_data_storage_flush_delay(message, response);
+		case FID_FLUSH_DATA_STORAGE:                         return length != sizeof(FlushDataStorage)                     ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : flush_data_storage(message);
+		case FID_GET_DATA_STORAGE_STATUS:                    return length != sizeof(GetDataStorageStatus)                 ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : get_data_storage_status(message, response);
+		case FID_GET_DATA_STORAGE_PAGES_LOW_LEVEL:           return length != sizeof(GetDataStoragePagesLowLevel)          ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : get_data_storage_pages_low_level(message, response);
+		case FID_SET_DATA_STORAGE_PAGES_LOW_LEVEL:           return length != sizeof(SetDataStoragePagesLowLevel)          ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : set_data_storage_pages_low_level(message, response);
+		case FID_GET_SD_STATISTICS:                          return length != sizeof(GetSDStatistics)                      ? HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER : get_sd_statistics(message, response);
 		default: return HANDLE_MESSAGE_RESPONSE_NOT_SUPPORTED;
 	}
 }
@@ -279,24 +476,14 @@ BootloaderHandleMessageResponse get_sd_information(const GetSDInformation *data,
 
 BootloaderHandleMessageResponse set_sd_wallbox_data_point(const SetSDWallboxDataPoint *data, SetSDWallboxDataPoint_Response *response) {
 	response->header.length = sizeof(SetSDWallboxDataPoint_Response);
-	response->status        = get_sd_lfs_status(sd.wallbox_data_point_end, SD_WALLBOX_DATA_POINT_LENGTH);
-	if(response->status != WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK) {
-		return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
-	}
-	response->status        = get_date_status(data->year, data->month, data->day, data->hour, data->minute);
-	if(response->status != WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK) {
-		return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
-	}
-
-	memcpy(&sd.wallbox_data_point[sd.wallbox_data_point_end], &data->wallbox_id, sizeof(SetSDWallboxDataPoint) - sizeof(TFPMessageHeader));
-	sd.wallbox_data_point_end++;
+	response->status        = add_sd_wallbox_data_point(data);
 
 	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
 }
 
 BootloaderHandleMessageResponse get_sd_wallbox_data_points(const GetSDWallboxDataPoints *data, GetSDWallboxDataPoints_Response *response) {
 	response->header.length = sizeof(GetSDWallboxDataPoints_Response);
-	response->status        = get_sd_lfs_status(sd.new_sd_wallbox_data_points ? 1: 0, 1);
+	response->status        = get_sd_lfs_status(sd.new_sd_wallbox_data_points || sd_query_is_active(WARP_ENERGY_MANAGER_V2_DATA_TYPE_WALLBOX));
 	if(response->status != WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK) {
 		return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
 	}
@@ -311,30 +498,21 @@ BootloaderHandleMessageResponse get_sd_wallbox_data_points(const GetSDWallboxDat
 
 	sd.get_sd_wallbox_data_points = *data;
 	sd.new_sd_wallbox_data_points = true;
+	sd_query_direct_stream_begin(WARP_ENERGY_MANAGER_V2_DATA_TYPE_WALLBOX);
 
 	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
 }
 
 BootloaderHandleMessageResponse set_sd_wallbox_daily_data_point(const SetSDWallboxDailyDataPoint *data, SetSDWallboxDailyDataPoint_Response *response) {
 	response->header.length = sizeof(SetSDWallboxDailyDataPoint_Response);
-	response->status        = get_sd_lfs_status(sd.wallbox_daily_data_point_end, SD_WALLBOX_DAILY_DATA_POINT_LENGTH);
-	if(response->status != WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK) {
-		return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
-	}
-	response->status        = get_date_status(data->year, data->month, data->day, 0, 0);
-	if(response->status != WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK) {
-		return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
-	}
-
-	memcpy(&sd.wallbox_daily_data_point[sd.wallbox_daily_data_point_end], &data->wallbox_id, sizeof(SetSDWallboxDailyDataPoint) - sizeof(TFPMessageHeader));
-	sd.wallbox_daily_data_point_end++;
+	response->status        = add_sd_wallbox_daily_data_point(data);
 
 	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
 }
 
 BootloaderHandleMessageResponse get_sd_wallbox_daily_data_points(const GetSDWallboxDailyDataPoints *data, GetSDWallboxDailyDataPoints_Response *response) {
 	response->header.length = sizeof(GetSDWallboxDailyDataPoints_Response);
-	response->status        = get_sd_lfs_status(sd.new_sd_wallbox_daily_data_points ? 1: 0, 1);
+	response->status        = get_sd_lfs_status(sd.new_sd_wallbox_daily_data_points || sd_query_is_active(WARP_ENERGY_MANAGER_V2_DATA_TYPE_WALLBOX_DAILY));
 	if(response->status != WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK) {
 		return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
 	}
@@ -349,30 +527,21 @@ BootloaderHandleMessageResponse get_sd_wallbox_daily_data_points(const GetSDWall
 
 	sd.get_sd_wallbox_daily_data_points = *data;
 	sd.new_sd_wallbox_daily_data_points = true;
+	sd_query_direct_stream_begin(WARP_ENERGY_MANAGER_V2_DATA_TYPE_WALLBOX_DAILY);
 
 	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
 }
 
 BootloaderHandleMessageResponse set_sd_energy_manager_data_point(const SetSDEnergyManagerDataPoint *data, SetSDEnergyManagerDataPoint_Response *response) {
 	response->header.length = sizeof(SetSDEnergyManagerDataPoint_Response);
-	response->status        = get_sd_lfs_status(sd.energy_manager_data_point_end, SD_ENERGY_MANAGER_DATA_POINT_LENGTH);
-	if(response->status != WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK) {
-		return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
-	}
-	response->status        = get_date_status(data->year, data->month, data->day, data->hour, data->minute);
-	if(response->status != WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK) {
-		return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
-	}
-
-	memcpy(&sd.energy_manager_data_point[sd.energy_manager_data_point_end], &data->year, sizeof(SetSDEnergyManagerDataPoint) - sizeof(TFPMessageHeader));
-	sd.energy_manager_data_point_end++;
+	response->status        = add_sd_energy_manager_data_point(data);
 
 	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
 }
 
 BootloaderHandleMessageResponse get_sd_energy_manager_data_points(const GetSDEnergyManagerDataPoints *data, GetSDEnergyManagerDataPoints_Response *response) {
 	response->header.length = sizeof(GetSDEnergyManagerDataPoints_Response);
-	response->status        = get_sd_lfs_status(sd.new_sd_energy_manager_data_points ? 1: 0, 1);
+	response->status        = get_sd_lfs_status(sd.new_sd_energy_manager_data_points || sd_query_is_active(WARP_ENERGY_MANAGER_V2_DATA_TYPE_ENERGY_MANAGER));
 	if(response->status != WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK) {
 		return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
 	}
@@ -387,30 +556,21 @@ BootloaderHandleMessageResponse get_sd_energy_manager_data_points(const GetSDEne
 
 	sd.get_sd_energy_manager_data_points = *data;
 	sd.new_sd_energy_manager_data_points = true;
+	sd_query_direct_stream_begin(WARP_ENERGY_MANAGER_V2_DATA_TYPE_ENERGY_MANAGER);
 
 	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
 }
 
 BootloaderHandleMessageResponse set_sd_energy_manager_daily_data_point(const SetSDEnergyManagerDailyDataPoint *data, SetSDEnergyManagerDailyDataPoint_Response *response) {
 	response->header.length = sizeof(SetSDEnergyManagerDailyDataPoint_Response);
-	response->status        = get_sd_lfs_status(sd.energy_manager_daily_data_point_end, SD_ENERGY_MANAGER_DAILY_DATA_POINT_LENGTH);
-	if(response->status != WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK) {
-		return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
-	}
-	response->status        = get_date_status(data->year, data->month, data->day, 0, 0);
-	if(response->status != WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK) {
-		return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
-	}
-
-	memcpy(&sd.energy_manager_daily_data_point[sd.energy_manager_daily_data_point_end], &data->year, sizeof(SetSDEnergyManagerDailyDataPoint) - sizeof(TFPMessageHeader));
-	sd.energy_manager_daily_data_point_end++;
+	response->status        = add_sd_energy_manager_daily_data_point(data);
 
 	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
 }
 
 BootloaderHandleMessageResponse get_sd_energy_manager_daily_data_points(const GetSDEnergyManagerDailyDataPoints *data, GetSDEnergyManagerDailyDataPoints_Response *response) {
 	response->header.length = sizeof(GetSDEnergyManagerDailyDataPoints_Response);
-	response->status        = get_sd_lfs_status(sd.new_sd_energy_manager_daily_data_points ? 1: 0, 1);
+	response->status        = get_sd_lfs_status(sd.new_sd_energy_manager_daily_data_points || sd_query_is_active(WARP_ENERGY_MANAGER_V2_DATA_TYPE_ENERGY_MANAGER_DAILY));
 	if(response->status != WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK) {
 		return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
 	}
@@ -425,6 +585,7 @@ BootloaderHandleMessageResponse get_sd_energy_manager_daily_data_points(const Ge
 
 	sd.get_sd_energy_manager_daily_data_points = *data;
 	sd.new_sd_energy_manager_daily_data_points = true;
+	sd_query_direct_stream_begin(WARP_ENERGY_MANAGER_V2_DATA_TYPE_ENERGY_MANAGER_DAILY);
 
 	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
 }
@@ -495,15 +656,7 @@ BootloaderHandleMessageResponse set_data_storage(const SetDataStorage *data) {
 		return HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER;
 	}
 
-	// Copy data into storage and set new change time.
-	// Data will be copied from RAM to SD after 10 minutes.
-	if(!data_storage.has_been_written_once[data->page] || (memcmp(data_storage.storage[data->page], data->data, 63) != 0)) {
-		data_storage.file_not_found[data->page] = false;
-		memcpy(data_storage.storage[data->page], data->data, 63);
-		if(data_storage.last_change_time[data->page] == 0) {
-			data_storage.last_change_time[data->page] = system_timer_get_ms();
-		}
-	}
+	write_data_storage_page(data->page, data->data);
 
 	return HANDLE_MESSAGE_RESPONSE_EMPTY;
 }
@@ -515,13 +668,312 @@ BootloaderHandleMessageResponse reset_energy_meter_relative_energy(const ResetEn
 	return HANDLE_MESSAGE_RESPONSE_EMPTY;
 }
 
+BootloaderHandleMessageResponse set_sd_wallbox_data_points_low_level(const SetSDWallboxDataPointsLowLevel *data, SetSDWallboxDataPointsLowLevel_Response *response) {
+	response->header.length        = sizeof(SetSDWallboxDataPointsLowLevel_Response);
+	response->status               = handle_data_point_stream(&sd_wallbox_data_point_stream,
+	                                                          &sd_wallbox_data_point_stream_data_point,
+	                                                          sizeof(SetSDWallboxDataPoint) - sizeof(TFPMessageHeader),
+	                                                          add_sd_wallbox_data_point_from_stream,
+	                                                          data->data_length,
+	                                                          data->data_chunk_offset,
+	                                                          data->data_chunk_data,
+	                                                          sizeof(data->data_chunk_data));
+	response->data_points_accepted = sd_wallbox_data_point_stream.data_points_accepted;
+	response->data_points_free     = sd_queue_get_free(SD_QUEUE_WALLBOX_DATA_POINT);
+
+	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
+}
+
+BootloaderHandleMessageResponse set_sd_energy_manager_data_points_low_level(const SetSDEnergyManagerDataPointsLowLevel *data, SetSDEnergyManagerDataPointsLowLevel_Response *response) {
+	response->header.length        = sizeof(SetSDEnergyManagerDataPointsLowLevel_Response);
+	response->status               = handle_data_point_stream(&sd_energy_manager_data_point_stream,
+	                                                          &sd_energy_manager_data_point_stream_data_point,
+	                                                          sizeof(SetSDEnergyManagerDataPoint) - sizeof(TFPMessageHeader),
+	                                                          add_sd_energy_manager_data_point_from_stream,
+	                                                          data->data_length,
+	                                                          data->data_chunk_offset,
+	                                                          data->data_chunk_data,
+	                                                          sizeof(data->data_chunk_data));
+	response->data_points_accepted = sd_energy_manager_data_point_stream.data_points_accepted;
+	response->data_points_free     = sd_queue_get_free(SD_QUEUE_ENERGY_MANAGER_DATA_POINT);
+
+	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
+}
+
+BootloaderHandleMessageResponse get_sd_queue_status(const GetSDQueueStatus *data, GetSDQueueStatus_Response *response) {
+	response->header.length                         = sizeof(GetSDQueueStatus_Response);
+	response->wallbox_data_points_free              = sd_queue_get_free(SD_QUEUE_WALLBOX_DATA_POINT);
+	response->wallbox_daily_data_points_free        = sd_queue_get_free(SD_QUEUE_WALLBOX_DAILY_DATA_POINT);
+	response->energy_manager_data_points_free       = sd_queue_get_free(SD_QUEUE_ENERGY_MANAGER_DATA_POINT);
+	response->energy_manager_daily_data_points_free = sd_queue_get_free(SD_QUEUE_ENERGY_MANAGER_DAILY_DATA_POINT);
+
+	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
+}
+
+BootloaderHandleMessageResponse get_main_loop_latency(const GetMainLoopLatency *data, GetMainLoopLatency_Response *response) {
+	response->header.length = sizeof(GetMainLoopLatency_Response);
+	response->loop_max      = latency.loop_max;
+
+	// Maximum is measured since the last call
+	latency_init();
+
+	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
+}
+
+BootloaderHandleMessageResponse get_sd_data_points_range(const GetSDDataPointsRange *data, GetSDDataPointsRange_Response *response) {
+	response->header.length = sizeof(GetSDDataPointsRange_Response);
+	response->request_id    = 0;
+	response->status        = get_sd_lfs_status(sd_query_is_queue_full());
+	if(response->status != WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK) {
+		return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
+	}
+	response->status        = get_date_status(data->start_year, data->start_month, data->start_day, data->start_hour, data->start_minute);
+	if(response->status != WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK) {
+		return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
+	}
+	response->status        = get_date_status(data->end_year, data->end_month, data->end_day, data->end_hour, data->end_minute);
+	if(response->status != WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK) {
+		return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
+	}
+
+	SDQueryRequest request = {
+		.data_type  = data->data_type,
+		.wallbox_id = data->wallbox_id,
+		.start      = {data->start_year, data->start_month, data->start_day, data->start_hour, data->start_minute},
+		.end        = {data->end_year,   data->end_month,   data->end_day,   data->end_hour,   data->end_minute},
+		.compress   = data->compress
+	};
+	response->status        = sd_query_request(&request);
+	response->request_id    = request.request_id;
+
+	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
+}
+
+BootloaderHandleMessageResponse get_sd_energy_manager_data_points_aggregated(const GetSDEnergyManagerDataPointsAggregated *data, GetSDEnergyManagerDataPointsAggregated_Response *response) {
+	response->header.length = sizeof(GetSDEnergyManagerDataPointsAggregated_Response);
+	response->request_id    = 0;
+	response->status        = get_sd_lfs_status(sd_query_is_queue_full());
+	if(response->status != WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK) {
+		return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
+	}
+	response->status        = get_date_status(data->start_year, data->start_month, data->start_day, data->start_hour, 0);
+	if(response->status != WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK) {
+		return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
+	}
+	response->status        = get_date_status(data->end_year, data->end_month, data->end_day, data->end_hour, 0);
+	if(response->status != WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK) {
+		return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
+	}
+
+	// The buckets are streamed through the SDDataPointsRange callback
+	SDQueryRequest request = {
+		.data_type  = WARP_ENERGY_MANAGER_V2_DATA_TYPE_ENERGY_MANAGER,
+		.start      = {data->start_year, data->start_month, data->start_day, data->start_hour, 0},
+		.end        = {data->end_year,   data->end_month,   data->end_day,   data->end_hour,   0},
+		.aggregate  = true,
+		.interval   = data->interval
+	};
+	response->status        = sd_query_request(&request);
+	response->request_id    = request.request_id;
+
+	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
+}
+
+BootloaderHandleMessageResponse get_sd_data_points_export(const GetSDDataPointsExport *data, GetSDDataPointsExport_Response *response) {
+	response->header.length = sizeof(GetSDDataPointsExport_Response);
+	response->request_id    = 0;
+	response->cursor_end    = 0;
+	response->status        = get_sd_lfs_status(sd_query_is_queue_full());
+	if(response->status != WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK) {
+		return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
+	}
+	response->status        = get_date_status(data->end_year, data->end_month, data->end_day, 0, 0);
+	if(response->status != WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK) {
+		return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
+	}
+
+	// The cursor counts data points (5 minutes or days) since 2000-01-01.
+	// An interrupted export is resumed with the cursor plus the number of
+	// data points that were received.
+	SDQueryRequest request = {
+		.data_type  = data->data_type,
+		.wallbox_id = data->wallbox_id,
+		.end        = {data->end_year, data->end_month, data->end_day, 0, 0},
+		.compress   = data->compress
+	};
+	if(!sd_query_get_date(data->data_type, data->cursor, &request.start)) {
+		response->status    = WARP_ENERGY_MANAGER_V2_DATA_STATUS_DATE_OUT_OF_RANGE;
+		return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
+	}
+
+	response->status        = sd_query_request(&request);
+	response->request_id    = request.request_id;
+	if(response->status == WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK) {
+		response->cursor_end = sd_query_get_slot(data->data_type, &request.end);
+	}
+
+	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
+}
+
+BootloaderHandleMessageResponse set_sd_wallbox_daily_data_points_low_level(const SetSDWallboxDailyDataPointsLowLevel *data, SetSDWallboxDailyDataPointsLowLevel_Response *response) {
+	response->header.length        = sizeof(SetSDWallboxDailyDataPointsLowLevel_Response);
+	response->status               = handle_data_point_stream(&sd_wallbox_daily_data_point_stream,
+	                                                          &sd_wallbox_daily_data_point_stream_data_point,
+	                                                          sizeof(SetSDWallboxDailyDataPoint) - sizeof(TFPMessageHeader),
+	                                                          add_sd_wallbox_daily_data_point_from_stream,
+	                                                          data->data_length,
+	                                                          data->data_chunk_offset,
+	                                                          data->data_chunk_data,
+	                                                          sizeof(data->data_chunk_data));
+	response->data_points_accepted = sd_wallbox_daily_data_point_stream.data_points_accepted;
+	response->data_points_free     = sd_queue_get_free(SD_QUEUE_WALLBOX_DAILY_DATA_POINT);
+
+	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
+}
+
+BootloaderHandleMessageResponse set_sd_energy_manager_daily_data_points_low_level(const SetSDEnergyManagerDailyDataPointsLowLevel *data, SetSDEnergyManagerDailyDataPointsLowLevel_Response *response) {
+	response->header.length        = sizeof(SetSDEnergyManagerDailyDataPointsLowLevel_Response);
+	response->status               = handle_data_point_stream(&sd_energy_manager_daily_data_point_stream,
+	                                                          &sd_energy_manager_daily_data_point_stream_data_point,
+	                                                          sizeof(SetSDEnergyManagerDailyDataPoint) - sizeof(TFPMessageHeader),
+	                                                          add_sd_energy_manager_daily_data_point_from_stream,
+	                                                          data->data_length,
+	                                                          data->data_chunk_offset,
+	                                                          data->data_chunk_data,
+	                                                          sizeof(data->data_chunk_data));
+	response->data_points_accepted = sd_energy_manager_daily_data_point_stream.data_points_accepted;
+	response->data_points_free     = sd_queue_get_free(SD_QUEUE_ENERGY_MANAGER_DAILY_DATA_POINT);
+
+	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
+}
+
+BootloaderHandleMessageResponse set_data_storage_flush_delay(const SetDataStorageFlushDelay *data) {
+	if((data->page >= DATA_STORAGE_PAGES) || (data->delay > DATA_STORAGE_FLUSH_DELAY_MAX)) {
+		return HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER;
+	}
+
+	data_storage_flush.delay[data->page] = data->delay;
+
+	return HANDLE_MESSAGE_RESPONSE_EMPTY;
+}
+
+BootloaderHandleMessageResponse get_data_storage_flush_delay(const GetDataStorageFlushDelay *data, GetDataStorageFlushDelay_Response *response) {
+	if(data->page >= DATA_STORAGE_PAGES) {
+		return HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER;
+	}
+
+	response->header.length = sizeof(GetDataStorageFlushDelay_Response);
+	response->delay         = data_storage_flush.delay[data->page];
+
+	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
+}
+
+BootloaderHandleMessageResponse flush_data_storage(const FlushDataStorage *data) {
+	for(uint8_t page = 0; page < DATA_STORAGE_PAGES; page++) {
+		data_storage_flush_page(page);
+	}
+
+	return HANDLE_MESSAGE_RESPONSE_EMPTY;
+}
+
+BootloaderHandleMessageResponse get_data_storage_status(const GetDataStorageStatus *data, GetDataStorageStatus_Response *response) {
+	response->header.length = sizeof(GetDataStorageStatus_Response);
+	response->dirty_pages   = 0;
+
+	// Bit n is set if page n has changes that are not written to SD yet
+	for(uint8_t page = 0; page < MIN(DATA_STORAGE_PAGES, 16); page++) {
+		if(data_storage_flush_is_dirty(page)) {
+			response->dirty_pages |= 1 << page;
+		}
+	}
+
+	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
+}
+
+BootloaderHandleMessageResponse get_data_storage_pages_low_level(const GetDataStoragePagesLowLevel *data, GetDataStoragePagesLowLevel_Response *response) {
+	// Each page is streamed as status byte followed by the 63 data bytes.
+	// The host asks for each chunk by offset, a stream that was abandoned
+	// halfway does not affect the next one.
+	const uint16_t offset = data->pages_chunk_offset;
+	const uint16_t length = DATA_STORAGE_PAGES*64;
+	if((offset >= length) || ((offset % sizeof(response->pages_chunk_data)) != 0)) {
+		return HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER;
+	}
+
+	response->header.length      = sizeof(GetDataStoragePagesLowLevel_Response);
+	response->pages_length       = length;
+	response->pages_chunk_offset = offset;
+
+	for(uint8_t i = 0; i < sizeof(response->pages_chunk_data); i++) {
+		const uint16_t position = offset + i;
+		const uint8_t page      = position / 64;
+		const uint8_t index     = position % 64;
+
+		if(position >= length) {
+			response->pages_chunk_data[i] = 0;
+		} else if(index > 0) {
+			response->pages_chunk_data[i] = data_storage.storage[page][index - 1];
+		} else if(data_storage.file_not_found[page]) {
+			response->pages_chunk_data[i] = WARP_ENERGY_MANAGER_V2_DATA_STORAGE_STATUS_NOT_FOUND;
+		} else if(data_storage.read_from_sd[page]) {
+			response->pages_chunk_data[i] = WARP_ENERGY_MANAGER_V2_DATA_STORAGE_STATUS_BUSY;
+		} else {
+			response->pages_chunk_data[i] = WARP_ENERGY_MANAGER_V2_DATA_STORAGE_STATUS_OK;
+		}
+	}
+
+	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
+}
+
+BootloaderHandleMessageResponse set_data_storage_pages_low_level(const SetDataStoragePagesLowLevel *data, SetDataStoragePagesLowLevel_Response *response) {
+	// Only whole 64 byte page records can be written
+	if((data->pages_length > DATA_STORAGE_PAGES*64) || ((data->pages_length % 64) != 0)) {
+		return HANDLE_MESSAGE_RESPONSE_INVALID_PARAMETER;
+	}
+
+	response->header.length  = sizeof(SetDataStoragePagesLowLevel_Response);
+	response->status         = handle_data_point_stream(&data_storage_page_stream,
+	                                                    &data_storage_page_stream_page,
+	                                                    sizeof(DataStoragePage) - sizeof(TFPMessageHeader),
+	                                                    add_data_storage_page_from_stream,
+	                                                    data->pages_length,
+	                                                    data->pages_chunk_offset,
+	                                                    data->pages_chunk_data,
+	                                                    sizeof(data->pages_chunk_data));
+	response->pages_accepted = data_storage_page_stream.data_points_accepted;
+
+	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
+}
+
+BootloaderHandleMessageResponse get_sd_statistics(const GetSDStatistics *data, GetSDStatistics_Response *response) {
+	response->header.length = sizeof(GetSDStatistics_Response);
+	response->sd_tick_min   = sd_statistics.tick_min;
+	response->sd_tick_avg   = (sd_statistics.tick_count == 0) ? 0 : sd_statistics.tick_sum / sd_statistics.tick_count;
+	response->sd_tick_max   = sd_statistics.tick_max;
+
+	for(uint8_t i = 0; i < SD_STATISTICS_HISTOGRAM_NUM; i++) {
+		response->sd_tick_histogram[i] = sd_statistics.tick_histogram[i];
+	}
+
+	for(uint8_t i = 0; i < SD_QUEUE_NUM; i++) {
+		response->queue_high_water[i] = sd_statistics.queue_high_water[i];
+		response->queue_full[i]       = sd_statistics.queue_full[i];
+	}
+
+	// Statistics are measured since the last call
+	sd_statistics_init();
+
+	return HANDLE_MESSAGE_RESPONSE_NEW_MESSAGE;
+}
+
 
 bool handle_sd_wallbox_data_points_low_level_callback(void) {
 	static bool is_buffered = false;
 	static SDWallboxDataPointsLowLevel_Callback cb;
 
 	if(!is_buffered) {
-		if(!sd.new_sd_wallbox_data_points_cb) {
+		// Chunks of a range query are consumed by sd_query
+		if(!sd.new_sd_wallbox_data_points_cb || sd_query_is_active(WARP_ENERGY_MANAGER_V2_DATA_TYPE_WALLBOX)) {
 			return false;
 		}
 
@@ -531,6 +983,7 @@ bool handle_sd_wallbox_data_points_low_level_callback(void) {
 		memcpy(cb.data_chunk_data, sd.sd_wallbox_data_points_cb_data, SD_WALLBOX_DATA_POINT_CB_LENGTH);
 
 		sd.new_sd_wallbox_data_points_cb = false;
+		sd_query_direct_stream_chunk(WARP_ENERGY_MANAGER_V2_DATA_TYPE_WALLBOX, cb.data_chunk_offset, cb.data_length, SD_WALLBOX_DATA_POINT_CB_LENGTH);
 	}
 
 	if(bootloader_spitfp_is_send_possible(&bootloader_status.st)) {
@@ -549,7 +1002,8 @@ bool handle_sd_wallbox_daily_data_points_low_level_callback(void) {
 	static SDWallboxDailyDataPointsLowLevel_Callback cb;
 
 	if(!is_buffered) {
-		if(!sd.new_sd_wallbox_daily_data_points_cb) {
+		// Chunks of a range query are consumed by sd_query
+		if(!sd.new_sd_wallbox_daily_data_points_cb || sd_query_is_active(WARP_ENERGY_MANAGER_V2_DATA_TYPE_WALLBOX_DAILY)) {
 			return false;
 		}
 
@@ -559,6 +1013,7 @@ bool handle_sd_wallbox_daily_data_points_low_level_callback(void) {
 		memcpy(cb.data_chunk_data, sd.sd_wallbox_daily_data_points_cb_data, SD_WALLBOX_DAILY_DATA_POINT_CB_LENGTH);
 
 		sd.new_sd_wallbox_daily_data_points_cb = false;
+		sd_query_direct_stream_chunk(WARP_ENERGY_MANAGER_V2_DATA_TYPE_WALLBOX_DAILY, cb.data_chunk_offset*sizeof(uint32_t), cb.data_length*sizeof(uint32_t), SD_WALLBOX_DAILY_DATA_POINT_CB_LENGTH);
 	}
 
 	if(bootloader_spitfp_is_send_possible(&bootloader_status.st)) {
@@ -577,7 +1032,8 @@ bool handle_sd_energy_manager_data_points_low_level_callback(void) {
 	static SDEnergyManagerDataPointsLowLevel_Callback cb;
 
 	if(!is_buffered) {
-		if(!sd.new_sd_energy_manager_data_points_cb) {
+		// Chunks of a range query are consumed by sd_query
+		if(!sd.new_sd_energy_manager_data_points_cb || sd_query_is_active(WARP_ENERGY_MANAGER_V2_DATA_TYPE_ENERGY_MANAGER)) {
 			return false;
 		}
 
@@ -587,6 +1043,7 @@ bool handle_sd_energy_manager_data_points_low_level_callback(void) {
 		memcpy(cb.data_chunk_data, sd.sd_energy_manager_data_points_cb_data, SD_ENERGY_MANAGER_DATA_POINT_CB_LENGTH);
 
 		sd.new_sd_energy_manager_data_points_cb = false;
+		sd_query_direct_stream_chunk(WARP_ENERGY_MANAGER_V2_DATA_TYPE_ENERGY_MANAGER, cb.data_chunk_offset, cb.data_length, SD_ENERGY_MANAGER_DATA_POINT_CB_LENGTH);
 	}
 
 	if(bootloader_spitfp_is_send_possible(&bootloader_status.st)) {
@@ -605,7 +1062,8 @@ bool handle_sd_energy_manager_daily_data_points_low_level_callback(void) {
 	static SDEnergyManagerDailyDataPointsLowLevel_Callback cb;
 
 	if(!is_buffered) {
-		if(!sd.new_sd_energy_manager_daily_data_points_cb) {
+		// Chunks of a range query are consumed by sd_query
+		if(!sd.new_sd_energy_manager_daily_data_points_cb || sd_query_is_active(WARP_ENERGY_MANAGER_V2_DATA_TYPE_ENERGY_MANAGER_DAILY)) {
 			return false;
 		}
 
@@ -615,6 +1073,7 @@ bool handle_sd_energy_manager_daily_data_points_low_level_callback(void) {
 		memcpy(cb.data_chunk_data, sd.sd_energy_manager_daily_data_points_cb_data, SD_ENERGY_MANAGER_DAILY_DATA_POINT_CB_LENGTH);
 
 		sd.new_sd_energy_manager_daily_data_points_cb = false;
+		sd_query_direct_stream_chunk(WARP_ENERGY_MANAGER_V2_DATA_TYPE_ENERGY_MANAGER_DAILY, cb.data_chunk_offset*sizeof(uint32_t), cb.data_length*sizeof(uint32_t), SD_ENERGY_MANAGER_DAILY_DATA_POINT_CB_LENGTH);
 	}
 
 	if(bootloader_spitfp_is_send_possible(&bootloader_status.st)) {
@@ -628,6 +1087,67 @@ bool handle_sd_energy_manager_daily_data_points_low_level_callback(void) {
 	return false;
 }
 
+bool handle_sd_data_points_range_low_level_callback(void) {
+	static bool is_buffered = false;
+	static SDDataPointsRangeLowLevel_Callback cb;
+
+	if(!is_buffered) {
+		if(!sd_query.new_cb || sd_query.compress) {
+			return false;
+		}
+
+		tfp_make_default_header(&cb.header, bootloader_get_uid(), sizeof(SDDataPointsRangeLowLevel_Callback), FID_CALLBACK_SD_DATA_POINTS_RANGE_LOW_LEVEL);
+		cb.request_id = sd_query.request_id;
+		cb.status = sd_query.cb_status;
+		cb.data_length = sd_query.cb_data_length;
+		cb.data_chunk_offset = sd_query.cb_offset;
+		memcpy(cb.data_chunk_data, sd_query.cb_data, SD_QUERY_CB_LENGTH);
+
+		sd_query.new_cb = false;
+	}
+
+	if(bootloader_spitfp_is_send_possible(&bootloader_status.st)) {
+		bootloader_spitfp_send_ack_and_message(&bootloader_status, (uint8_t*)&cb, sizeof(SDDataPointsRangeLowLevel_Callback));
+		is_buffered = false;
+		return true;
+	} else {
+		is_buffered = true;
+	}
+
+	return false;
+}
+
+bool handle_sd_data_points_range_compressed_low_level_callback(void) {
+	static bool is_buffered = false;
+	static SDDataPointsRangeCompressedLowLevel_Callback cb;
+
+	if(!is_buffered) {
+		if(!sd_query.new_cb || !sd_query.compress) {
+			return false;
+		}
+
+		tfp_make_default_header(&cb.header, bootloader_get_uid(), sizeof(SDDataPointsRangeCompressedLowLevel_Callback), FID_CALLBACK_SD_DATA_POINTS_RANGE_COMPRESSED_LOW_LEVEL);
+		cb.request_id = sd_query.request_id;
+		cb.status = sd_query.cb_status;
+		cb.data_length = sd_query.cb_data_length;
+		cb.data_chunk_offset = sd_query.cb_offset;
+		cb.data_chunk_length = sd_query.cb_chunk_length;
+		memcpy(cb.data_chunk_data, sd_query.cb_data, SD_QUERY_CB_COMPRESSED_LENGTH);
+
+		sd_query.new_cb = false;
+	}
+
+	if(bootloader_spitfp_is_send_possible(&bootloader_status.st)) {
+		bootloader_spitfp_send_ack_and_message(&bootloader_status, (uint8_t*)&cb, sizeof(SDDataPointsRangeCompressedLowLevel_Callback));
+		is_buffered = false;
+		return true;
+	} else {
+		is_buffered = true;
+	}
+
+	return false;
+}
+
 void communication_tick(void) {
 	communication_callback_tick();
 }
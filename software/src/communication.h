@@ -52,6 +52,17 @@ void communication_init(void);
 #define WARP_ENERGY_MANAGER_V2_DATA_STATUS_LFS_ERROR 2
 #define WARP_ENERGY_MANAGER_V2_DATA_STATUS_QUEUE_FULL 3
 #define WARP_ENERGY_MANAGER_V2_DATA_STATUS_DATE_OUT_OF_RANGE 4
+#define WARP_ENERGY_MANAGER_V2_DATA_STATUS_STREAM_OUT_OF_SYNC 5
+#define WARP_ENERGY_MANAGER_V2_DATA_STATUS_TIMEOUT 6
+
+#define WARP_ENERGY_MANAGER_V2_DATA_TYPE_WALLBOX 0
+#define WARP_ENERGY_MANAGER_V2_DATA_TYPE_WALLBOX_DAILY 1
+#define WARP_ENERGY_MANAGER_V2_DATA_TYPE_ENERGY_MANAGER 2
+#define WARP_ENERGY_MANAGER_V2_DATA_TYPE_ENERGY_MANAGER_DAILY 3
+
+#define WARP_ENERGY_MANAGER_V2_AGGREGATION_INTERVAL_HOUR 0
+#define WARP_ENERGY_MANAGER_V2_AGGREGATION_INTERVAL_DAY 1
+#define WARP_ENERGY_MANAGER_V2_AGGREGATION_INTERVAL_MONTH 2
 
 #define WARP_ENERGY_MANAGER_V2_FORMAT_STATUS_OK 0
 #define WARP_ENERGY_MANAGER_V2_FORMAT_STATUS_PASSWORD_ERROR 1
@@ -111,11 +122,29 @@ void communication_init(void);
 #define FID_GET_DATA_STORAGE 28
 #define FID_SET_DATA_STORAGE 29
 #define FID_RESET_ENERGY_METER_RELATIVE_ENERGY 30
+#define FID_SET_SD_WALLBOX_DATA_POINTS_LOW_LEVEL 31
+#define FID_SET_SD_ENERGY_MANAGER_DATA_POINTS_LOW_LEVEL 32
+#define FID_GET_SD_QUEUE_STATUS 33
+#define FID_GET_MAIN_LOOP_LATENCY 34
+#define FID_GET_SD_DATA_POINTS_RANGE 35
+#define FID_GET_SD_ENERGY_MANAGER_DATA_POINTS_AGGREGATED 37
+#define FID_GET_SD_DATA_POINTS_EXPORT 40
+#define FID_SET_SD_WALLBOX_DAILY_DATA_POINTS_LOW_LEVEL 41
+#define FID_SET_SD_ENERGY_MANAGER_DAILY_DATA_POINTS_LOW_LEVEL 42
+#define FID_SET_DATA_STORAGE_FLUSH_DELAY 43
+#define FID_GET_DATA_STORAGE_FLUSH_DELAY 44
+#define FID_FLUSH_DATA_STORAGE 45
+#define FID_GET_DATA_STORAGE_STATUS 46
+#define FID_GET_DATA_STORAGE_PAGES_LOW_LEVEL 47
+#define FID_SET_DATA_STORAGE_PAGES_LOW_LEVEL 48
+#define FID_GET_SD_STATISTICS 49
 
 #define FID_CALLBACK_SD_WALLBOX_DATA_POINTS_LOW_LEVEL 21
 #define FID_CALLBACK_SD_WALLBOX_DAILY_DATA_POINTS_LOW_LEVEL 22
 #define FID_CALLBACK_SD_ENERGY_MANAGER_DATA_POINTS_LOW_LEVEL 23
 #define FID_CALLBACK_SD_ENERGY_MANAGER_DAILY_DATA_POINTS_LOW_LEVEL 24
+#define FID_CALLBACK_SD_DATA_POINTS_RANGE_LOW_LEVEL 36
+#define FID_CALLBACK_SD_DATA_POINTS_RANGE_COMPRESSED_LOW_LEVEL 38
 
 typedef struct {
 	TFPMessageHeader header;
@@ -447,6 +476,230 @@ typedef struct {
 	TFPMessageHeader header;
 } __attribute__((__packed__)) ResetEnergyMeterRelativeEnergy;
 
+typedef struct {
+	TFPMessageHeader header;
+	uint16_t data_length;
+	uint16_t data_chunk_offset;
+	uint8_t data_chunk_data[60];
+} __attribute__((__packed__)) SetSDWallboxDataPointsLowLevel;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint8_t status;
+	uint16_t data_points_accepted;
+	uint16_t data_points_free;
+} __attribute__((__packed__)) SetSDWallboxDataPointsLowLevel_Response;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint16_t data_length;
+	uint16_t data_chunk_offset;
+	uint8_t data_chunk_data[60];
+} __attribute__((__packed__)) SetSDEnergyManagerDataPointsLowLevel;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint8_t status;
+	uint16_t data_points_accepted;
+	uint16_t data_points_free;
+} __attribute__((__packed__)) SetSDEnergyManagerDataPointsLowLevel_Response;
+
+typedef struct {
+	TFPMessageHeader header;
+} __attribute__((__packed__)) GetSDQueueStatus;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint16_t wallbox_data_points_free;
+	uint16_t wallbox_daily_data_points_free;
+	uint16_t energy_manager_data_points_free;
+	uint16_t energy_manager_daily_data_points_free;
+} __attribute__((__packed__)) GetSDQueueStatus_Response;
+
+typedef struct {
+	TFPMessageHeader header;
+} __attribute__((__packed__)) GetMainLoopLatency;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint32_t loop_max;
+} __attribute__((__packed__)) GetMainLoopLatency_Response;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint8_t data_type;
+	uint32_t wallbox_id;
+	uint8_t start_year;
+	uint8_t start_month;
+	uint8_t start_day;
+	uint8_t start_hour;
+	uint8_t start_minute;
+	uint8_t end_year;
+	uint8_t end_month;
+	uint8_t end_day;
+	uint8_t end_hour;
+	uint8_t end_minute;
+	bool compress;
+} __attribute__((__packed__)) GetSDDataPointsRange;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint8_t status;
+	uint8_t request_id;
+} __attribute__((__packed__)) GetSDDataPointsRange_Response;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint8_t request_id;
+	uint8_t status;
+	uint32_t data_length;
+	uint32_t data_chunk_offset;
+	uint8_t data_chunk_data[54];
+} __attribute__((__packed__)) SDDataPointsRangeLowLevel_Callback;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint8_t interval;
+	uint8_t start_year;
+	uint8_t start_month;
+	uint8_t start_day;
+	uint8_t start_hour;
+	uint8_t end_year;
+	uint8_t end_month;
+	uint8_t end_day;
+	uint8_t end_hour;
+} __attribute__((__packed__)) GetSDEnergyManagerDataPointsAggregated;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint8_t status;
+	uint8_t request_id;
+} __attribute__((__packed__)) GetSDEnergyManagerDataPointsAggregated_Response;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint8_t request_id;
+	uint8_t status;
+	uint32_t data_length;
+	uint32_t data_chunk_offset;
+	uint8_t data_chunk_length;
+	uint8_t data_chunk_data[53];
+} __attribute__((__packed__)) SDDataPointsRangeCompressedLowLevel_Callback;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint8_t data_type;
+	uint32_t wallbox_id;
+	uint32_t cursor;
+	uint8_t end_year;
+	uint8_t end_month;
+	uint8_t end_day;
+	bool compress;
+} __attribute__((__packed__)) GetSDDataPointsExport;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint8_t status;
+	uint8_t request_id;
+	uint32_t cursor_end;
+} __attribute__((__packed__)) GetSDDataPointsExport_Response;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint16_t data_length;
+	uint16_t data_chunk_offset;
+	uint8_t data_chunk_data[60];
+} __attribute__((__packed__)) SetSDWallboxDailyDataPointsLowLevel;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint8_t status;
+	uint16_t data_points_accepted;
+	uint16_t data_points_free;
+} __attribute__((__packed__)) SetSDWallboxDailyDataPointsLowLevel_Response;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint16_t data_length;
+	uint16_t data_chunk_offset;
+	uint8_t data_chunk_data[60];
+} __attribute__((__packed__)) SetSDEnergyManagerDailyDataPointsLowLevel;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint8_t status;
+	uint16_t data_points_accepted;
+	uint16_t data_points_free;
+} __attribute__((__packed__)) SetSDEnergyManagerDailyDataPointsLowLevel_Response;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint8_t page;
+	uint16_t delay;
+} __attribute__((__packed__)) SetDataStorageFlushDelay;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint8_t page;
+} __attribute__((__packed__)) GetDataStorageFlushDelay;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint16_t delay;
+} __attribute__((__packed__)) GetDataStorageFlushDelay_Response;
+
+typedef struct {
+	TFPMessageHeader header;
+} __attribute__((__packed__)) FlushDataStorage;
+
+typedef struct {
+	TFPMessageHeader header;
+} __attribute__((__packed__)) GetDataStorageStatus;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint16_t dirty_pages;
+} __attribute__((__packed__)) GetDataStorageStatus_Response;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint16_t pages_chunk_offset;
+} __attribute__((__packed__)) GetDataStoragePagesLowLevel;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint16_t pages_length;
+	uint16_t pages_chunk_offset;
+	uint8_t pages_chunk_data[60];
+} __attribute__((__packed__)) GetDataStoragePagesLowLevel_Response;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint16_t pages_length;
+	uint16_t pages_chunk_offset;
+	uint8_t pages_chunk_data[60];
+} __attribute__((__packed__)) SetDataStoragePagesLowLevel;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint8_t status;
+	uint16_t pages_accepted;
+} __attribute__((__packed__)) SetDataStoragePagesLowLevel_Response;
+
+typedef struct {
+	TFPMessageHeader header;
+} __attribute__((__packed__)) GetSDStatistics;
+
+typedef struct {
+	TFPMessageHeader header;
+	uint32_t sd_tick_min;
+	uint32_t sd_tick_avg;
+	uint32_t sd_tick_max;
+	uint32_t sd_tick_histogram[8];
+	uint16_t queue_high_water[4];
+	uint16_t queue_full[4];
+} __attribute__((__packed__)) GetSDStatistics_Response;
+
 
 // Function prototypes
 BootloaderHandleMessageResponse get_energy_meter_values(const GetEnergyMeterValues *data, GetEnergyMeterValues_Response *response);
@@ -475,20 +728,40 @@ BootloaderHandleMessageResponse get_date_time(const GetDateTime *data, GetDateTi
 BootloaderHandleMessageResponse get_data_storage(const GetDataStorage *data, GetDataStorage_Response *response);
 BootloaderHandleMessageResponse set_data_storage(const SetDataStorage *data);
 BootloaderHandleMessageResponse reset_energy_meter_relative_energy(const ResetEnergyMeterRelativeEnergy *data);
+BootloaderHandleMessageResponse set_sd_wallbox_data_points_low_level(const SetSDWallboxDataPointsLowLevel *data, SetSDWallboxDataPointsLowLevel_Response *response);
+BootloaderHandleMessageResponse set_sd_energy_manager_data_points_low_level(const SetSDEnergyManagerDataPointsLowLevel *data, SetSDEnergyManagerDataPointsLowLevel_Response *response);
+BootloaderHandleMessageResponse get_sd_queue_status(const GetSDQueueStatus *data, GetSDQueueStatus_Response *response);
+BootloaderHandleMessageResponse get_main_loop_latency(const GetMainLoopLatency *data, GetMainLoopLatency_Response *response);
+BootloaderHandleMessageResponse get_sd_data_points_range(const GetSDDataPointsRange *data, GetSDDataPointsRange_Response *response);
+BootloaderHandleMessageResponse get_sd_energy_manager_data_points_aggregated(const GetSDEnergyManagerDataPointsAggregated *data, GetSDEnergyManagerDataPointsAggregated_Response *response);
+BootloaderHandleMessageResponse get_sd_data_points_export(const GetSDDataPointsExport *data, GetSDDataPointsExport_Response *response);
+BootloaderHandleMessageResponse set_sd_wallbox_daily_data_points_low_level(const SetSDWallboxDailyDataPointsLowLevel *data, SetSDWallboxDailyDataPointsLowLevel_Response *response);
+BootloaderHandleMessageResponse set_sd_energy_manager_daily_data_points_low_level(const SetSDEnergyManagerDailyDataPointsLowLevel *data, SetSDEnergyManagerDailyDataPointsLowLevel_Response *response);
+BootloaderHandleMessageResponse set_data_storage_flush_delay(const SetDataStorageFlushDelay *data);
+BootloaderHandleMessageResponse get_data_storage_flush_delay(const GetDataStorageFlushDelay *data, GetDataStorageFlushDelay_Response *response);
+BootloaderHandleMessageResponse flush_data_storage(const FlushDataStorage *data);
+BootloaderHandleMessageResponse get_data_storage_status(const GetDataStorageStatus *data, GetDataStorageStatus_Response *response);
+BootloaderHandleMessageResponse get_data_storage_pages_low_level(const GetDataStoragePagesLowLevel *data, GetDataStoragePagesLowLevel_Response *response);
+BootloaderHandleMessageResponse set_data_storage_pages_low_level(const SetDataStoragePagesLowLevel *data, SetDataStoragePagesLowLevel_Response *response);
+BootloaderHandleMessageResponse get_sd_statistics(const GetSDStatistics *data, GetSDStatistics_Response *response);
 
 // Callbacks
 bool handle_sd_wallbox_data_points_low_level_callback(void);
 bool handle_sd_wallbox_daily_data_points_low_level_callback(void);
 bool handle_sd_energy_manager_data_points_low_level_callback(void);
 bool handle_sd_energy_manager_daily_data_points_low_level_callback(void);
+bool handle_sd_data_points_range_low_level_callback(void);
+bool handle_sd_data_points_range_compressed_low_level_callback(void);
 
 #define COMMUNICATION_CALLBACK_TICK_WAIT_MS 1
-#define COMMUNICATION_CALLBACK_HANDLER_NUM 4
+#define COMMUNICATION_CALLBACK_HANDLER_NUM 6
 #define COMMUNICATION_CALLBACK_LIST_INIT \
 	handle_sd_wallbox_data_points_low_level_callback, \
 	handle_sd_wallbox_daily_data_points_low_level_callback, \
 	handle_sd_energy_manager_data_points_low_level_callback, \
 	handle_sd_energy_manager_daily_data_points_low_level_callback, \
+	handle_sd_data_points_range_low_level_callback, \
+	handle_sd_data_points_range_compressed_low_level_callback, \
 
 
 #endif
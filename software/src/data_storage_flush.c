@@ -0,0 +1,64 @@
+/* warp-energy-manager-v2-bricklet
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * data_storage_flush.c: Flush policy for the data storage pages
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+// data_storage.c writes a page to SD once its last_change_time is
+// 10 minutes in the past and then resets it to 0. A page is flushed
+// earlier by moving its last_change_time back by these 10 minutes.
+
+#include "data_storage_flush.h"
+
+#include "bricklib2/hal/system_timer/system_timer.h"
+
+DataStorageFlush data_storage_flush;
+
+bool data_storage_flush_is_dirty(const uint8_t page) {
+	return data_storage.last_change_time[page] != 0;
+}
+
+void data_storage_flush_page(const uint8_t page) {
+	if(!data_storage_flush_is_dirty(page)) {
+		return;
+	}
+
+	// 0 means not dirty
+	uint32_t time = system_timer_get_ms() - (DATA_STORAGE_FLUSH_DELAY_MAX*1000 + 1);
+	if(time == 0) {
+		time--;
+	}
+
+	data_storage.last_change_time[page] = time;
+}
+
+void data_storage_flush_init(void) {
+	for(uint8_t page = 0; page < DATA_STORAGE_PAGES; page++) {
+		data_storage_flush.delay[page] = DATA_STORAGE_FLUSH_DELAY_MAX;
+	}
+}
+
+void data_storage_flush_tick(void) {
+	for(uint8_t page = 0; page < DATA_STORAGE_PAGES; page++) {
+		if((data_storage_flush.delay[page] < DATA_STORAGE_FLUSH_DELAY_MAX) &&
+		   data_storage_flush_is_dirty(page) &&
+		   system_timer_is_time_elapsed_ms(data_storage.last_change_time[page], data_storage_flush.delay[page]*1000)) {
+			data_storage_flush_page(page);
+		}
+	}
+}
@@ -0,0 +1,44 @@
+/* warp-energy-manager-v2-bricklet
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * data_storage_flush.h: Flush policy for the data storage pages
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef DATA_STORAGE_FLUSH_H
+#define DATA_STORAGE_FLUSH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "data_storage.h"
+
+// Pages are written by data_storage.c 10 minutes after the first change
+#define DATA_STORAGE_FLUSH_DELAY_MAX 600 // s
+
+typedef struct {
+	uint16_t delay[DATA_STORAGE_PAGES]; // s
+} DataStorageFlush;
+
+extern DataStorageFlush data_storage_flush;
+
+bool data_storage_flush_is_dirty(const uint8_t page);
+void data_storage_flush_page(const uint8_t page);
+void data_storage_flush_init(void);
+void data_storage_flush_tick(void);
+
+#endif
@@ -0,0 +1,56 @@
+/* warp-energy-manager-v2-bricklet
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * latency.c: Main loop latency measurement
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#include "latency.h"
+
+#include <string.h>
+
+#include "xmc_common.h"
+
+#include "bricklib2/hal/system_timer/system_timer.h"
+
+Latency latency;
+
+// The system timer counts milliseconds in the SysTick interrupt. SysTick
+// itself counts down from LOAD once per millisecond at core clock, so it
+// gives the position within the current millisecond.
+uint32_t latency_get_us(void) {
+	uint32_t ms;
+	uint32_t val;
+	do {
+		ms  = system_timer_get_ms();
+		val = SysTick->VAL;
+	} while(ms != system_timer_get_ms());
+
+	const uint32_t load = SysTick->LOAD;
+	return ms*1000 + ((load - val)*1000) / (load + 1);
+}
+
+void latency_update(const uint32_t start) {
+	const uint32_t duration = latency_get_us() - start;
+	if(duration > latency.loop_max) {
+		latency.loop_max = duration;
+	}
+}
+
+void latency_init(void) {
+	memset(&latency, 0, sizeof(Latency));
+}
@@ -0,0 +1,38 @@
+/* warp-energy-manager-v2-bricklet
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * latency.h: Main loop latency measurement
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct {
+	uint32_t loop_max; // us, one iteration of the main loop
+} Latency;
+
+extern Latency latency;
+
+uint32_t latency_get_us(void);
+void latency_update(const uint32_t start);
+void latency_init(void);
+
+#endif
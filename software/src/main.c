@@ -32,16 +32,22 @@
 #include "communication.h"
 
 #include "io.h"
+#include "latency.h"
 #include "voltage.h"
 #include "eeprom.h"
 #include "date_time.h"
 #include "sd.h"
+#include "sd_queue.h"
+#include "sd_statistics.h"
+#include "sd_query.h"
 #include "data_storage.h"
+#include "data_storage_flush.h"
 
 int main(void) {
 	logging_init();
 	logd("Start WARP Energy Manager Bricklet 2.0\n\r");
 
+	latency_init();
 	communication_init();
 	io_init();
 	rs485_init();
@@ -50,8 +56,13 @@ int main(void) {
 	eeprom_init();
 	date_time_init();
 	data_storage_init();
+	data_storage_flush_init();
+	sd_queue_init();
+	sd_statistics_init();
+	sd_query_init();
 	sd_init();
 
+	uint32_t loop_start = latency_get_us();
 	while(true) {
 		bootloader_tick();
 		communication_tick();
@@ -60,7 +71,17 @@ int main(void) {
 		meter_tick();
 		voltage_tick();
 		date_time_tick();
+		sd_queue_tick();
+		sd_query_tick();
+
+		const uint32_t sd_tick_start = system_timer_get_ms();
 		sd_tick();
+		sd_statistics_update_tick(sd_tick_start);
+
+		data_storage_flush_tick();
 		data_storage_tick();
+
+		latency_update(loop_start);
+		loop_start = latency_get_us();
 	}
 }
@@ -0,0 +1,162 @@
+/* warp-energy-manager-v2-bricklet
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * sd_aggregate.c: Aggregation of energy manager data points
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+// The 5 minute data points of a range query are consumed here instead of
+// being streamed. One bucket per hour, day or month is put into the
+// sd_query buffer. Data points that are all zero (not written or padded
+// because the file is missing) are not counted.
+
+#include "sd_aggregate.h"
+
+#include <string.h>
+
+#include "communication.h"
+
+SDAggregate sd_aggregate;
+
+bool sd_aggregate_is_aligned(const uint8_t interval, const SDQueryDate *date) {
+	switch(interval) {
+		case WARP_ENERGY_MANAGER_V2_AGGREGATION_INTERVAL_HOUR:  return date->minute == 0;
+		case WARP_ENERGY_MANAGER_V2_AGGREGATION_INTERVAL_DAY:   return (date->minute == 0) && (date->hour == 0);
+		case WARP_ENERGY_MANAGER_V2_AGGREGATION_INTERVAL_MONTH: return (date->minute == 0) && (date->hour == 0) && (date->day == 1);
+		default: return false;
+	}
+}
+
+static uint32_t sd_aggregate_get_bucket_slots(const uint8_t interval, const SDQueryDate *date) {
+	switch(interval) {
+		case WARP_ENERGY_MANAGER_V2_AGGREGATION_INTERVAL_HOUR:  return 12;
+		case WARP_ENERGY_MANAGER_V2_AGGREGATION_INTERVAL_DAY:   return SD_QUERY_5MIN_SLOTS_PER_DAY;
+		case WARP_ENERGY_MANAGER_V2_AGGREGATION_INTERVAL_MONTH: return sd_query_days_in_month(date->year, date->month)*SD_QUERY_5MIN_SLOTS_PER_DAY;
+		default: return 1;
+	}
+}
+
+static void sd_aggregate_next_bucket_date(SDQueryDate *date) {
+	// Only month buckets depend on the date
+	if(sd_aggregate.interval != WARP_ENERGY_MANAGER_V2_AGGREGATION_INTERVAL_MONTH) {
+		return;
+	}
+
+	date->month++;
+	if(date->month > 12) {
+		date->month = 1;
+		date->year++;
+	}
+}
+
+// Start and end have to be aligned to the interval, so the range always
+// consists of complete buckets. The count is not found by stepping through
+// the buckets, a range over many years would block the main loop.
+uint32_t sd_aggregate_get_bucket_count(const uint8_t interval, const SDQueryDate *start, const SDQueryDate *end, const uint32_t slots) {
+	if(interval == WARP_ENERGY_MANAGER_V2_AGGREGATION_INTERVAL_MONTH) {
+		return (uint32_t)((end->year - start->year)*12 + end->month - start->month);
+	}
+
+	return slots / sd_aggregate_get_bucket_slots(interval, start);
+}
+
+static void sd_aggregate_reset_bucket(void) {
+	memset(&sd_aggregate.bucket, 0, sizeof(SDAggregateBucket));
+	for(uint8_t i = 0; i < SD_AGGREGATE_CHANNEL_NUM; i++) {
+		sd_aggregate.bucket.min[i] = INT32_MAX;
+		sd_aggregate.bucket.max[i] = INT32_MIN;
+	}
+
+	sd_aggregate.bucket_slots      = sd_aggregate_get_bucket_slots(sd_aggregate.interval, &sd_aggregate.date);
+	sd_aggregate.bucket_slots_done = 0;
+}
+
+static void sd_aggregate_finish_bucket(void) {
+	SDAggregateBucket *bucket = &sd_aggregate.bucket;
+	for(uint8_t i = 0; i < SD_AGGREGATE_CHANNEL_NUM; i++) {
+		if(bucket->count == 0) {
+			bucket->min[i] = 0;
+			bucket->max[i] = 0;
+			bucket->avg[i] = 0;
+		} else {
+			bucket->avg[i] = (int32_t)(bucket->sum[i] / bucket->count);
+		}
+	}
+
+	// sd_aggregate_get_input_space guarantees that the bucket fits
+	memcpy(&sd_query.buffer[sd_query.buffer_used], bucket, sizeof(SDAggregateBucket));
+	sd_query.buffer_used += sizeof(SDAggregateBucket);
+
+	sd_aggregate_next_bucket_date(&sd_aggregate.date);
+	sd_aggregate_reset_bucket();
+}
+
+static void sd_aggregate_add_data_point(void) {
+	static const uint8_t zero[SD_DATA_POINT_ENERGY_MANAGER_SIZE] = {0};
+
+	// Missing data points are padded with zeros, a data point that was
+	// written with all values at zero is skipped the same way
+	if(memcmp(sd_aggregate.data_point, zero, SD_DATA_POINT_ENERGY_MANAGER_SIZE) != 0) {
+		SetSDEnergyManagerDataPoint data_point;
+		memcpy(&data_point.flags, sd_aggregate.data_point, SD_DATA_POINT_ENERGY_MANAGER_SIZE);
+
+		SDAggregateBucket *bucket = &sd_aggregate.bucket;
+		for(uint8_t i = 0; i < SD_AGGREGATE_CHANNEL_NUM; i++) {
+			const int32_t power = i == 0 ? data_point.power_grid : data_point.power_general[i-1];
+			bucket->sum[i] += power;
+			if(power < bucket->min[i]) {
+				bucket->min[i] = power;
+			}
+			if(power > bucket->max[i]) {
+				bucket->max[i] = power;
+			}
+		}
+		bucket->count++;
+	}
+
+	sd_aggregate.bucket_slots_done++;
+	if(sd_aggregate.bucket_slots_done >= sd_aggregate.bucket_slots) {
+		sd_aggregate_finish_bucket();
+	}
+}
+
+// Number of bytes that can be added without overflowing the sd_query buffer
+uint16_t sd_aggregate_get_input_space(const uint16_t buffer_free) {
+	if(buffer_free < sizeof(SDAggregateBucket)) {
+		return 0;
+	}
+
+	return SD_DATA_POINT_ENERGY_MANAGER_SIZE - sd_aggregate.data_point_used;
+}
+
+// data == NULL adds zeros
+void sd_aggregate_add(const uint8_t *data, const uint16_t length) {
+	for(uint16_t i = 0; i < length; i++) {
+		sd_aggregate.data_point[sd_aggregate.data_point_used++] = data == NULL ? 0 : data[i];
+		if(sd_aggregate.data_point_used == SD_DATA_POINT_ENERGY_MANAGER_SIZE) {
+			sd_aggregate_add_data_point();
+			sd_aggregate.data_point_used = 0;
+		}
+	}
+}
+
+void sd_aggregate_init(const uint8_t interval, const SDQueryDate *start) {
+	memset(&sd_aggregate, 0, sizeof(SDAggregate));
+	sd_aggregate.interval = interval;
+	sd_aggregate.date     = *start;
+	sd_aggregate_reset_bucket();
+}
@@ -0,0 +1,64 @@
+/* warp-energy-manager-v2-bricklet
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * sd_aggregate.h: Aggregation of energy manager data points
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef SD_AGGREGATE_H
+#define SD_AGGREGATE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "sd_query.h"
+#include "sd_data_point.h"
+
+#define SD_AGGREGATE_CHANNEL_NUM 7 // power_grid, power_general[6]
+
+// Data points that are all zero are treated as missing: They are left out
+// of count, sum, min and max, even if they were written with all values
+// at zero.
+typedef struct {
+	uint16_t count; // Number of data points that are not all zero
+	int64_t sum[SD_AGGREGATE_CHANNEL_NUM];
+	int32_t min[SD_AGGREGATE_CHANNEL_NUM];
+	int32_t max[SD_AGGREGATE_CHANNEL_NUM];
+	int32_t avg[SD_AGGREGATE_CHANNEL_NUM];
+} __attribute__((__packed__)) SDAggregateBucket;
+
+typedef struct {
+	uint8_t interval;
+	SDQueryDate date; // Start of current bucket
+
+	uint8_t data_point[SD_DATA_POINT_ENERGY_MANAGER_SIZE];
+	uint8_t data_point_used;
+
+	uint32_t bucket_slots;
+	uint32_t bucket_slots_done;
+	SDAggregateBucket bucket;
+} SDAggregate;
+
+extern SDAggregate sd_aggregate;
+
+bool sd_aggregate_is_aligned(const uint8_t interval, const SDQueryDate *date);
+uint32_t sd_aggregate_get_bucket_count(const uint8_t interval, const SDQueryDate *start, const SDQueryDate *end, const uint32_t slots);
+uint16_t sd_aggregate_get_input_space(const uint16_t buffer_free);
+void sd_aggregate_add(const uint8_t *data, const uint16_t length);
+void sd_aggregate_init(const uint8_t interval, const SDQueryDate *start);
+
+#endif
@@ -0,0 +1,104 @@
+/* warp-energy-manager-v2-bricklet
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * sd_codec.c: Delta + zig-zag varint encoding of SD data points
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+// Every field of a data point is encoded as the zig-zag encoded difference
+// to the same field of the previous data point, as a little endian base
+// 128 varint. The codec is reset at the start of every compressed stream.
+// Unused channels and slowly changing values take one byte per field
+// instead of four.
+
+#include "sd_codec.h"
+
+#include <string.h>
+
+#include "communication.h"
+#include "sd_data_point.h"
+
+typedef struct {
+	uint8_t field_num;
+	uint8_t field_size[SD_CODEC_FIELD_MAX];
+} SDCodecLayout;
+
+#define SD_CODEC_SIZE(type, field) sizeof(((type*)0)->field)
+#define SD_CODEC_WB(field)          SD_CODEC_SIZE(SetSDWallboxDataPoint, field)
+#define SD_CODEC_WB_DAILY(field)    SD_CODEC_SIZE(SetSDWallboxDailyDataPoint, field)
+#define SD_CODEC_EM(field)          SD_CODEC_SIZE(SetSDEnergyManagerDataPoint, field)
+#define SD_CODEC_EM_DAILY(field)    SD_CODEC_SIZE(SetSDEnergyManagerDailyDataPoint, field)
+
+// Same layout as the data points in the SD callback streams (see sd_data_point.h)
+static const SDCodecLayout sd_codec_layout[SD_DATA_POINT_TYPE_NUM] = {
+	{2, {SD_CODEC_WB(flags), SD_CODEC_WB(power)}},
+	{1, {SD_CODEC_WB_DAILY(energy)}},
+	{9, {
+		SD_CODEC_EM(flags), SD_CODEC_EM(power_grid),
+		SD_CODEC_EM(power_general[0]), SD_CODEC_EM(power_general[1]), SD_CODEC_EM(power_general[2]),
+		SD_CODEC_EM(power_general[3]), SD_CODEC_EM(power_general[4]), SD_CODEC_EM(power_general[5]),
+		SD_CODEC_EM(price)
+	}},
+	{15, {
+		SD_CODEC_EM_DAILY(energy_grid_in), SD_CODEC_EM_DAILY(energy_grid_out),
+		SD_CODEC_EM_DAILY(energy_general_in[0]), SD_CODEC_EM_DAILY(energy_general_in[1]), SD_CODEC_EM_DAILY(energy_general_in[2]),
+		SD_CODEC_EM_DAILY(energy_general_in[3]), SD_CODEC_EM_DAILY(energy_general_in[4]), SD_CODEC_EM_DAILY(energy_general_in[5]),
+		SD_CODEC_EM_DAILY(energy_general_out[0]), SD_CODEC_EM_DAILY(energy_general_out[1]), SD_CODEC_EM_DAILY(energy_general_out[2]),
+		SD_CODEC_EM_DAILY(energy_general_out[3]), SD_CODEC_EM_DAILY(energy_general_out[4]), SD_CODEC_EM_DAILY(energy_general_out[5]),
+		SD_CODEC_EM_DAILY(price)
+	}}
+};
+
+static uint32_t sd_codec_read_field(const uint8_t *data, const uint8_t size) {
+	uint32_t value = 0;
+	for(uint8_t i = 0; i < size; i++) {
+		value |= ((uint32_t)data[i]) << (i*8);
+	}
+
+	return value;
+}
+
+// Deltas are calculated modulo 2^32, this works for signed and unsigned fields
+static uint32_t sd_codec_zigzag_encode(const uint32_t delta) {
+	return (delta << 1) ^ (0U - (delta >> 31));
+}
+
+// Returns the number of bytes written to out (at most SD_CODEC_ENCODED_MAX)
+uint8_t sd_codec_encode(SDCodec *codec, const uint8_t *data_point, uint8_t *out) {
+	const SDCodecLayout *layout = &sd_codec_layout[codec->data_type];
+	uint8_t length = 0;
+
+	for(uint8_t i = 0; i < layout->field_num; i++) {
+		const uint32_t value = sd_codec_read_field(data_point, layout->field_size[i]);
+		uint32_t zigzag = sd_codec_zigzag_encode(value - codec->last[i]);
+		codec->last[i] = value;
+		data_point    += layout->field_size[i];
+
+		while(zigzag >= 0x80) {
+			out[length++] = (uint8_t)(zigzag | 0x80);
+			zigzag >>= 7;
+		}
+		out[length++] = (uint8_t)zigzag;
+	}
+
+	return length;
+}
+
+void sd_codec_init(SDCodec *codec, const uint8_t data_type) {
+	memset(codec, 0, sizeof(SDCodec));
+	codec->data_type = data_type < SD_DATA_POINT_TYPE_NUM ? data_type : 0;
+}
@@ -0,0 +1,42 @@
+/* warp-energy-manager-v2-bricklet
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * sd_codec.h: Delta + zig-zag varint encoding of SD data points
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef SD_CODEC_H
+#define SD_CODEC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SD_CODEC_FIELD_MAX 15
+#define SD_CODEC_VARINT_MAX 5
+
+// Worst case size of one encoded data point
+#define SD_CODEC_ENCODED_MAX (SD_CODEC_FIELD_MAX*SD_CODEC_VARINT_MAX)
+
+typedef struct {
+	uint8_t data_type;
+	uint32_t last[SD_CODEC_FIELD_MAX];
+} SDCodec;
+
+uint8_t sd_codec_encode(SDCodec *codec, const uint8_t *data_point, uint8_t *out);
+void sd_codec_init(SDCodec *codec, const uint8_t data_type);
+
+#endif
@@ -0,0 +1,43 @@
+/* warp-energy-manager-v2-bricklet
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * sd_data_point.c: Layout of the data points in the SD streams
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include "sd_data_point.h"
+
+static const uint8_t sd_data_point_size[SD_DATA_POINT_TYPE_NUM] = {
+	SD_DATA_POINT_WALLBOX_SIZE,
+	SD_DATA_POINT_WALLBOX_DAILY_SIZE,
+	SD_DATA_POINT_ENERGY_MANAGER_SIZE,
+	SD_DATA_POINT_ENERGY_MANAGER_DAILY_SIZE
+};
+
+uint8_t sd_data_point_get_size(const uint8_t data_type) {
+	if(data_type >= SD_DATA_POINT_TYPE_NUM) {
+		return 0;
+	}
+
+	return sd_data_point_size[data_type];
+}
+
+bool sd_data_point_is_daily(const uint8_t data_type) {
+	return (data_type == WARP_ENERGY_MANAGER_V2_DATA_TYPE_WALLBOX_DAILY) ||
+	       (data_type == WARP_ENERGY_MANAGER_V2_DATA_TYPE_ENERGY_MANAGER_DAILY);
+}
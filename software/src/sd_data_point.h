@@ -0,0 +1,47 @@
+/* warp-energy-manager-v2-bricklet
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * sd_data_point.h: Layout of the data points in the SD streams
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#ifndef SD_DATA_POINT_H
+#define SD_DATA_POINT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "communication.h"
+
+#define SD_DATA_POINT_TYPE_NUM 4
+
+// A data point in the callback streams of the SD get functions is the
+// Set*DataPoint without header, wallbox ID and date
+#define SD_DATA_POINT_WALLBOX_SIZE              (sizeof(SetSDWallboxDataPoint)            - offsetof(SetSDWallboxDataPoint, flags))
+#define SD_DATA_POINT_WALLBOX_DAILY_SIZE        (sizeof(SetSDWallboxDailyDataPoint)       - offsetof(SetSDWallboxDailyDataPoint, energy))
+#define SD_DATA_POINT_ENERGY_MANAGER_SIZE       (sizeof(SetSDEnergyManagerDataPoint)      - offsetof(SetSDEnergyManagerDataPoint, flags))
+#define SD_DATA_POINT_ENERGY_MANAGER_DAILY_SIZE (sizeof(SetSDEnergyManagerDailyDataPoint) - offsetof(SetSDEnergyManagerDailyDataPoint, energy_grid_in))
+
+// Largest of the sizes above
+#define SD_DATA_POINT_SIZE_MAX SD_DATA_POINT_ENERGY_MANAGER_DAILY_SIZE
+
+uint8_t sd_data_point_get_size(const uint8_t data_type);
+bool sd_data_point_is_daily(const uint8_t data_type);
+
+#endif
@@ -0,0 +1,650 @@
+/* warp-energy-manager-v2-bricklet
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * sd_query.c: Range queries over SD data points
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+// A range query is split into one SD query per day (5 minute data) or
+// per month (daily data). The SD callback chunks of all parts are
+// concatenated into one byte stream. The next part is requested as soon
+// as the last chunk of the previous part is in the buffer, so the next
+// file is opened while the buffered data is still being sent.
+//
+// An SD or littlefs error or a part that times out aborts the query. The
+// last callback then has the error status, see sd_query_fill_cb.
+//
+// Compressed streams consist of items: A varint with the number of
+// repetitions of the previous data point, followed by the next changed
+// data point in sd_codec encoding. The last item may only consist of the
+// repetition count. The codec state starts at an all zero data point.
+
+#include "sd_query.h"
+
+#include <string.h>
+
+#include "bricklib2/hal/system_timer/system_timer.h"
+#include "bricklib2/utility/util_definitions.h"
+
+#include "communication.h"
+#include "sd.h"
+#include "sd_aggregate.h"
+#include "sd_data_point.h"
+#include "sdmmc.h"
+
+SDQuery sd_query;
+SDQueryQueue sd_query_queue;
+
+// Streams of the get_sd_* functions that are read directly from sd.c. A
+// range query of the same data type waits until such a stream has ended,
+// otherwise both would use the same SD request and callback buffer.
+static bool sd_query_direct_stream_active[SD_DATA_POINT_TYPE_NUM];
+static uint32_t sd_query_direct_stream_time[SD_DATA_POINT_TYPE_NUM];
+
+static bool sd_query_is_leap_year(const uint8_t year) {
+	const uint16_t y = 2000 + year;
+	return (((y % 4) == 0) && ((y % 100) != 0)) || ((y % 400) == 0);
+}
+
+uint8_t sd_query_days_in_month(const uint8_t year, const uint8_t month) {
+	static const uint8_t days[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+	if((month == 2) && sd_query_is_leap_year(year)) {
+		return 29;
+	}
+
+	return days[month-1];
+}
+
+static uint32_t sd_query_days_since_2000(const SDQueryDate *date) {
+	// Leap years in [2000, 2000+year)
+	const uint32_t year       = date->year;
+	const uint32_t leap_years = (year + 3)/4 - (year + 99)/100 + (year + 399)/400;
+	uint32_t days = year*365 + leap_years;
+
+	for(uint8_t month = 1; month < date->month; month++) {
+		days += sd_query_days_in_month(date->year, month);
+	}
+
+	return days + date->day - 1;
+}
+
+// Index of the 5 minute slot or day since 2000
+uint32_t sd_query_get_slot(const uint8_t data_type, const SDQueryDate *date) {
+	const uint32_t days = sd_query_days_since_2000(date);
+	if(sd_data_point_is_daily(data_type)) {
+		return days;
+	}
+
+	return days*SD_QUERY_5MIN_SLOTS_PER_DAY + date->hour*12 + date->minute/5;
+}
+
+// Inverse of sd_query_get_slot, returns false if the year does not fit
+bool sd_query_get_date(const uint8_t data_type, const uint32_t slot, SDQueryDate *date) {
+	uint32_t days = slot;
+	memset(date, 0, sizeof(SDQueryDate));
+
+	if(!sd_data_point_is_daily(data_type)) {
+		days              = slot / SD_QUERY_5MIN_SLOTS_PER_DAY;
+		const uint32_t ms = slot % SD_QUERY_5MIN_SLOTS_PER_DAY;
+		date->hour        = (uint8_t)(ms / 12);
+		date->minute      = (uint8_t)((ms % 12)*5);
+	}
+
+	uint8_t year = 0;
+	while(days >= (sd_query_is_leap_year(year) ? 366U : 365U)) {
+		days -= sd_query_is_leap_year(year) ? 366U : 365U;
+		if(year == UINT8_MAX) {
+			return false;
+		}
+		year++;
+	}
+
+	uint8_t month = 1;
+	while(days >= sd_query_days_in_month(year, month)) {
+		days -= sd_query_days_in_month(year, month);
+		month++;
+	}
+
+	date->year  = year;
+	date->month = month;
+	date->day   = (uint8_t)(days + 1);
+
+	return true;
+}
+
+static void sd_query_next_month(SDQueryDate *date) {
+	date->day = 1;
+	date->month++;
+	if(date->month > 12) {
+		date->month = 1;
+		date->year++;
+	}
+}
+
+static void sd_query_next_day(SDQueryDate *date) {
+	date->hour   = 0;
+	date->minute = 0;
+	date->day++;
+	if(date->day > sd_query_days_in_month(date->year, date->month)) {
+		sd_query_next_month(date);
+	}
+}
+
+static bool sd_query_is_sd_query_pending(const uint8_t data_type) {
+	switch(data_type) {
+		case WARP_ENERGY_MANAGER_V2_DATA_TYPE_WALLBOX:              return sd.new_sd_wallbox_data_points;
+		case WARP_ENERGY_MANAGER_V2_DATA_TYPE_WALLBOX_DAILY:        return sd.new_sd_wallbox_daily_data_points;
+		case WARP_ENERGY_MANAGER_V2_DATA_TYPE_ENERGY_MANAGER:       return sd.new_sd_energy_manager_data_points;
+		case WARP_ENERGY_MANAGER_V2_DATA_TYPE_ENERGY_MANAGER_DAILY: return sd.new_sd_energy_manager_daily_data_points;
+		default: return true;
+	}
+}
+
+static void sd_query_next_part(void) {
+	SDQueryDate *date = &sd_query.date;
+	uint32_t amount;
+
+	if(sd_data_point_is_daily(sd_query.data_type)) {
+		amount = MIN(sd_query.slots_left, (uint32_t)(sd_query_days_in_month(date->year, date->month) - date->day + 1));
+	} else {
+		amount = MIN(sd_query.slots_left, (uint32_t)(SD_QUERY_5MIN_SLOTS_PER_DAY - (date->hour*12 + date->minute/5)));
+	}
+
+	switch(sd_query.data_type) {
+		case WARP_ENERGY_MANAGER_V2_DATA_TYPE_WALLBOX: {
+			GetSDWallboxDataPoints *get = &sd.get_sd_wallbox_data_points;
+			get->wallbox_id = sd_query.wallbox_id;
+			get->year       = date->year;
+			get->month      = date->month;
+			get->day        = date->day;
+			get->hour       = date->hour;
+			get->minute     = date->minute;
+			get->amount     = (uint16_t)amount;
+			sd.new_sd_wallbox_data_points = true;
+			break;
+		}
+
+		case WARP_ENERGY_MANAGER_V2_DATA_TYPE_WALLBOX_DAILY: {
+			GetSDWallboxDailyDataPoints *get = &sd.get_sd_wallbox_daily_data_points;
+			get->wallbox_id = sd_query.wallbox_id;
+			get->year       = date->year;
+			get->month      = date->month;
+			get->day        = date->day;
+			get->amount     = (uint8_t)amount;
+			sd.new_sd_wallbox_daily_data_points = true;
+			break;
+		}
+
+		case WARP_ENERGY_MANAGER_V2_DATA_TYPE_ENERGY_MANAGER: {
+			GetSDEnergyManagerDataPoints *get = &sd.get_sd_energy_manager_data_points;
+			get->year       = date->year;
+			get->month      = date->month;
+			get->day        = date->day;
+			get->hour       = date->hour;
+			get->minute     = date->minute;
+			get->amount     = (uint16_t)amount;
+			sd.new_sd_energy_manager_data_points = true;
+			break;
+		}
+
+		case WARP_ENERGY_MANAGER_V2_DATA_TYPE_ENERGY_MANAGER_DAILY: {
+			GetSDEnergyManagerDailyDataPoints *get = &sd.get_sd_energy_manager_daily_data_points;
+			get->year       = date->year;
+			get->month      = date->month;
+			get->day        = date->day;
+			get->amount     = (uint8_t)amount;
+			sd.new_sd_energy_manager_daily_data_points = true;
+			break;
+		}
+
+		default: return;
+	}
+
+	if(sd_data_point_is_daily(sd_query.data_type)) {
+		sd_query_next_month(date);
+	} else {
+		sd_query_next_day(date);
+	}
+
+	sd_query.slots_left    -= amount;
+	sd_query.part_active    = true;
+	sd_query.part_padding   = false;
+	sd_query.part_length    = amount*sd_data_point_get_size(sd_query.data_type);
+	sd_query.part_received  = 0;
+	sd_query.part_time      = system_timer_get_ms();
+}
+
+static uint16_t sd_query_get_input_space(void) {
+	const uint16_t buffer_free = SD_QUERY_BUFFER_SIZE - sd_query.buffer_used;
+	if(sd_query.aggregate) {
+		return sd_aggregate_get_input_space(buffer_free);
+	}
+
+	if(sd_query.compress) {
+		if(buffer_free < (SD_CODEC_VARINT_MAX + SD_CODEC_ENCODED_MAX)) {
+			return 0;
+		}
+
+		return sd_data_point_get_size(sd_query.data_type) - sd_query.data_point_used;
+	}
+
+	return buffer_free;
+}
+
+static void sd_query_add_varint(uint32_t value) {
+	while(value >= 0x80) {
+		sd_query.buffer[sd_query.buffer_used++] = (uint8_t)(value | 0x80);
+		value >>= 7;
+	}
+	sd_query.buffer[sd_query.buffer_used++] = (uint8_t)value;
+}
+
+static void sd_query_compress_data_point(void) {
+	uint8_t encoded[SD_CODEC_ENCODED_MAX];
+	const uint8_t length = sd_codec_encode(&sd_query.codec, sd_query.data_point, encoded);
+
+	// Every field is encoded as a single zero byte if nothing changed
+	bool unchanged = true;
+	for(uint8_t i = 0; i < length; i++) {
+		if(encoded[i] != 0) {
+			unchanged = false;
+			break;
+		}
+	}
+
+	if(unchanged) {
+		sd_query.run++;
+		return;
+	}
+
+	sd_query_add_varint(sd_query.run);
+	memcpy(&sd_query.buffer[sd_query.buffer_used], encoded, length);
+	sd_query.buffer_used += length;
+	sd_query.run          = 0;
+}
+
+static void sd_query_compress(const uint8_t *data, const uint16_t length) {
+	const uint8_t size = sd_data_point_get_size(sd_query.data_type);
+	for(uint16_t i = 0; i < length; i++) {
+		sd_query.data_point[sd_query.data_point_used++] = data == NULL ? 0 : data[i];
+		if(sd_query.data_point_used == size) {
+			sd_query_compress_data_point();
+			sd_query.data_point_used = 0;
+		}
+	}
+}
+
+// data == NULL adds zeros
+static void sd_query_add_data(const uint8_t *data, const uint16_t length) {
+	if(sd_query.aggregate) {
+		sd_aggregate_add(data, length);
+	} else if(sd_query.compress) {
+		sd_query_compress(data, length);
+	} else if(data == NULL) {
+		memset(&sd_query.buffer[sd_query.buffer_used], 0, length);
+		sd_query.buffer_used += length;
+	} else {
+		memcpy(&sd_query.buffer[sd_query.buffer_used], data, length);
+		sd_query.buffer_used += length;
+	}
+
+	sd_query.part_received += length;
+}
+
+// The rest of the range is not read and the buffered data is dropped
+static void sd_query_abort(const uint8_t status) {
+	sd_query.status      = status;
+	sd_query.slots_left  = 0;
+	sd_query.part_active = false;
+	sd_query.buffer_used = 0;
+	sd_query.chunk_used  = 0;
+}
+
+// Copies the next SD callback chunk of the current part into the buffer.
+// A missing file or a stream that is shorter than requested is padded with
+// zeros and surplus data is dropped, so the stream has the announced length.
+static void sd_query_read_part(void) {
+	bool *new_cb;
+	uint32_t length;
+	uint32_t offset;
+	const uint8_t *data;
+	uint8_t chunk_length;
+
+	// Lengths and offsets of the daily streams are counted in uint32
+	switch(sd_query.data_type) {
+		case WARP_ENERGY_MANAGER_V2_DATA_TYPE_WALLBOX:
+			new_cb       = &sd.new_sd_wallbox_data_points_cb;
+			length       = sd.sd_wallbox_data_points_cb_data_length;
+			offset       = sd.sd_wallbox_data_points_cb_offset;
+			data         = sd.sd_wallbox_data_points_cb_data;
+			chunk_length = SD_WALLBOX_DATA_POINT_CB_LENGTH;
+			break;
+
+		case WARP_ENERGY_MANAGER_V2_DATA_TYPE_WALLBOX_DAILY:
+			new_cb       = &sd.new_sd_wallbox_daily_data_points_cb;
+			length       = sd.sd_wallbox_daily_data_points_cb_data_length*sizeof(uint32_t);
+			offset       = sd.sd_wallbox_daily_data_points_cb_offset*sizeof(uint32_t);
+			data         = (const uint8_t*)sd.sd_wallbox_daily_data_points_cb_data;
+			chunk_length = SD_WALLBOX_DAILY_DATA_POINT_CB_LENGTH;
+			break;
+
+		case WARP_ENERGY_MANAGER_V2_DATA_TYPE_ENERGY_MANAGER:
+			new_cb       = &sd.new_sd_energy_manager_data_points_cb;
+			length       = sd.sd_energy_manager_data_points_cb_data_length;
+			offset       = sd.sd_energy_manager_data_points_cb_offset;
+			data         = sd.sd_energy_manager_data_points_cb_data;
+			chunk_length = SD_ENERGY_MANAGER_DATA_POINT_CB_LENGTH;
+			break;
+
+		case WARP_ENERGY_MANAGER_V2_DATA_TYPE_ENERGY_MANAGER_DAILY:
+			new_cb       = &sd.new_sd_energy_manager_daily_data_points_cb;
+			length       = sd.sd_energy_manager_daily_data_points_cb_data_length*sizeof(uint32_t);
+			offset       = sd.sd_energy_manager_daily_data_points_cb_offset*sizeof(uint32_t);
+			data         = (const uint8_t*)sd.sd_energy_manager_daily_data_points_cb_data;
+			chunk_length = SD_ENERGY_MANAGER_DAILY_DATA_POINT_CB_LENGTH;
+			break;
+
+		default: return;
+	}
+
+	if(!*new_cb) {
+		// sd.c does not answer if the card or littlefs failed, the timeout
+		// only covers a card that stops answering without an error
+		if(sd.sd_status != SDMMC_ERROR_OK) {
+			sd_query_abort(WARP_ENERGY_MANAGER_V2_DATA_STATUS_SD_ERROR);
+		} else if(sd.lfs_status != LFS_ERR_OK) {
+			sd_query_abort(WARP_ENERGY_MANAGER_V2_DATA_STATUS_LFS_ERROR);
+		} else if(system_timer_is_time_elapsed_ms(sd_query.part_time, SD_QUERY_PART_TIMEOUT)) {
+			sd_query_abort(WARP_ENERGY_MANAGER_V2_DATA_STATUS_TIMEOUT);
+		}
+		return;
+	}
+
+	// Drop chunks that do not belong to the current part (e.g. the rest of a
+	// stream that arrived after a timeout)
+	if((offset + sd_query.chunk_used) != sd_query.part_received) {
+		sd_query.chunk_used = 0;
+		*new_cb = false;
+		return;
+	}
+
+	// A missing file is answered with an empty stream (or a stream that
+	// is shorter than requested), the rest of the part is padded at once
+	if(length <= sd_query.part_received) {
+		sd_query.part_padding = true;
+		sd_query.chunk_used   = 0;
+		*new_cb = false;
+		return;
+	}
+
+	// A chunk is consumed in several steps if the buffer can not take all of it
+	const uint32_t chunk_data_length = offset < length ? MIN((uint32_t)chunk_length, length - offset) : 0;
+	const uint32_t copy_length       = MIN(MIN(chunk_data_length - sd_query.chunk_used, sd_query.part_length - sd_query.part_received), (uint32_t)sd_query_get_input_space());
+	sd_query_add_data(&data[sd_query.chunk_used], (uint16_t)copy_length);
+	sd_query.chunk_used += copy_length;
+	sd_query.part_time   = system_timer_get_ms();
+
+	if(sd_query.part_received >= sd_query.part_length) {
+		sd_query.part_active = false;
+	} else if(sd_query.chunk_used < chunk_data_length) {
+		return;
+	} else if((offset + chunk_length) >= length) {
+		sd_query.part_padding = true;
+	}
+
+	sd_query.chunk_used = 0;
+	*new_cb = false;
+}
+
+static void sd_query_pad_part(void) {
+	const uint32_t pad_length = MIN((uint32_t)sd_query_get_input_space(), sd_query.part_length - sd_query.part_received);
+	sd_query_add_data(NULL, (uint16_t)pad_length);
+
+	if(sd_query.part_received >= sd_query.part_length) {
+		sd_query.part_active = false;
+	}
+}
+
+static void sd_query_fill_compressed_cb(void) {
+	const bool input_done = (sd_query.slots_left == 0) && !sd_query.part_active;
+	if(input_done && !sd_query.run_flushed && ((SD_QUERY_BUFFER_SIZE - sd_query.buffer_used) >= SD_CODEC_VARINT_MAX)) {
+		if(sd_query.run > 0) {
+			sd_query_add_varint(sd_query.run);
+		}
+		sd_query.run_flushed = true;
+	}
+
+	const uint8_t length = MIN(sd_query.buffer_used, SD_QUERY_CB_COMPRESSED_LENGTH);
+	if(length == 0) {
+		if(sd_query.run_flushed) {
+			sd_query.active = false;
+		}
+		return;
+	}
+
+	if((length < SD_QUERY_CB_COMPRESSED_LENGTH) && !sd_query.run_flushed) {
+		return;
+	}
+
+	sd_query.cb_data_length  = sd_query.data_length;
+	sd_query.cb_offset       = sd_query.data_offset;
+	sd_query.cb_chunk_length = length;
+	memcpy(sd_query.cb_data, sd_query.buffer, length);
+	memset(&sd_query.cb_data[length], 0, SD_QUERY_CB_LENGTH - length);
+
+	sd_query.buffer_used -= length;
+	memmove(sd_query.buffer, &sd_query.buffer[length], sd_query.buffer_used);
+
+	sd_query.data_offset += length;
+	sd_query.new_cb       = true;
+}
+
+// An aborted query ends with one callback that has the error status and no
+// data at the current offset. For uncompressed streams data_length is cut to
+// the bytes that were sent, so the stream is complete with the data read so
+// far. For compressed streams data_length stays the uncompressed length.
+static void sd_query_fill_abort_cb(void) {
+	sd_query.cb_status       = sd_query.status;
+	sd_query.cb_data_length  = sd_query.compress ? sd_query.data_length : sd_query.data_offset;
+	sd_query.cb_offset       = sd_query.data_offset;
+	sd_query.cb_chunk_length = 0;
+	memset(sd_query.cb_data, 0, SD_QUERY_CB_LENGTH);
+
+	sd_query.active = false;
+	sd_query.new_cb = true;
+}
+
+static void sd_query_fill_cb(void) {
+	if(sd_query.new_cb) {
+		return;
+	}
+
+	if(sd_query.status != WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK) {
+		sd_query_fill_abort_cb();
+		return;
+	}
+
+	if(sd_query.compress) {
+		sd_query_fill_compressed_cb();
+		return;
+	}
+
+	const uint32_t length = MIN(sd_query.data_length - sd_query.data_offset, SD_QUERY_CB_LENGTH);
+	if(length == 0) {
+		sd_query.active = false;
+		return;
+	}
+
+	if(sd_query.buffer_used < length) {
+		return;
+	}
+
+	sd_query.cb_data_length = sd_query.data_length;
+	sd_query.cb_offset      = sd_query.data_offset;
+	memcpy(sd_query.cb_data, sd_query.buffer, length);
+	memset(&sd_query.cb_data[length], 0, SD_QUERY_CB_LENGTH - length);
+
+	sd_query.buffer_used -= length;
+	memmove(sd_query.buffer, &sd_query.buffer[length], sd_query.buffer_used);
+
+	sd_query.data_offset += length;
+	sd_query.new_cb       = true;
+}
+
+static void sd_query_begin(const SDQueryRequest *request) {
+	const uint32_t start_slot = sd_query_get_slot(request->data_type, &request->start);
+	const uint32_t end_slot   = sd_query_get_slot(request->data_type, &request->end);
+
+	memset(&sd_query, 0, sizeof(SDQuery));
+	sd_query.request_id  = request->request_id;
+	sd_query.data_type   = request->data_type;
+	sd_query.wallbox_id  = request->wallbox_id;
+	sd_query.date        = request->start;
+	sd_query.slots_left  = end_slot - start_slot;
+	sd_query.data_length = sd_query.slots_left*sd_data_point_get_size(request->data_type);
+	sd_query.compress    = request->compress;
+	sd_query.aggregate   = request->aggregate;
+	sd_query.active      = true;
+	sd_codec_init(&sd_query.codec, request->data_type);
+
+	if(sd_data_point_is_daily(request->data_type)) {
+		sd_query.date.hour   = 0;
+		sd_query.date.minute = 0;
+	}
+
+	if(request->aggregate) {
+		sd_query.data_length = sd_aggregate_get_bucket_count(request->interval, &request->start, &request->end, sd_query.slots_left)*sizeof(SDAggregateBucket);
+		sd_aggregate_init(request->interval, &request->start);
+	}
+}
+
+static uint8_t sd_query_check_request(const SDQueryRequest *request) {
+	if(request->data_type >= SD_DATA_POINT_TYPE_NUM) {
+		return WARP_ENERGY_MANAGER_V2_DATA_STATUS_DATE_OUT_OF_RANGE;
+	}
+
+	if((request->start.day > sd_query_days_in_month(request->start.year, request->start.month)) ||
+	   (request->end.day   > sd_query_days_in_month(request->end.year, request->end.month))) {
+		return WARP_ENERGY_MANAGER_V2_DATA_STATUS_DATE_OUT_OF_RANGE;
+	}
+
+	if(request->aggregate) {
+		if((request->data_type != WARP_ENERGY_MANAGER_V2_DATA_TYPE_ENERGY_MANAGER) ||
+		   !sd_aggregate_is_aligned(request->interval, &request->start) ||
+		   !sd_aggregate_is_aligned(request->interval, &request->end)) {
+			return WARP_ENERGY_MANAGER_V2_DATA_STATUS_DATE_OUT_OF_RANGE;
+		}
+	}
+
+	// End is exclusive
+	if(sd_query_get_slot(request->data_type, &request->end) <= sd_query_get_slot(request->data_type, &request->start)) {
+		return WARP_ENERGY_MANAGER_V2_DATA_STATUS_DATE_OUT_OF_RANGE;
+	}
+
+	return WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK;
+}
+
+// Queues the request and assigns its request ID
+uint8_t sd_query_request(SDQueryRequest *request) {
+	if(sd_query_is_queue_full()) {
+		return WARP_ENERGY_MANAGER_V2_DATA_STATUS_QUEUE_FULL;
+	}
+
+	const uint8_t status = sd_query_check_request(request);
+	if(status != WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK) {
+		return status;
+	}
+
+	// Request ID 0 is never used
+	sd_query_queue.next_request_id++;
+	if(sd_query_queue.next_request_id == 0) {
+		sd_query_queue.next_request_id = 1;
+	}
+	request->request_id = sd_query_queue.next_request_id;
+
+	const uint8_t end = (sd_query_queue.start + sd_query_queue.count) % SD_QUERY_QUEUE_LENGTH;
+	sd_query_queue.request[end] = *request;
+	sd_query_queue.count++;
+
+	return WARP_ENERGY_MANAGER_V2_DATA_STATUS_OK;
+}
+
+bool sd_query_is_queue_full(void) {
+	return sd_query_queue.count >= SD_QUERY_QUEUE_LENGTH;
+}
+
+bool sd_query_is_active(const uint8_t data_type) {
+	return sd_query.active && (sd_query.data_type == data_type);
+}
+
+void sd_query_direct_stream_begin(const uint8_t data_type) {
+	sd_query_direct_stream_active[data_type] = true;
+	sd_query_direct_stream_time[data_type]   = system_timer_get_ms();
+}
+
+// Called for every chunk of a direct stream that is handed to the callback
+void sd_query_direct_stream_chunk(const uint8_t data_type, const uint32_t offset, const uint32_t length, const uint32_t chunk_length) {
+	sd_query_direct_stream_time[data_type] = system_timer_get_ms();
+	if((offset + chunk_length) >= length) {
+		sd_query_direct_stream_active[data_type] = false;
+	}
+}
+
+bool sd_query_is_direct_stream_active(const uint8_t data_type) {
+	// sd.c does not send anything after an SD error
+	if(sd_query_direct_stream_active[data_type] && system_timer_is_time_elapsed_ms(sd_query_direct_stream_time[data_type], SD_QUERY_PART_TIMEOUT)) {
+		sd_query_direct_stream_active[data_type] = false;
+	}
+
+	return sd_query_direct_stream_active[data_type];
+}
+
+void sd_query_init(void) {
+	memset(&sd_query, 0, sizeof(SDQuery));
+	memset(&sd_query_queue, 0, sizeof(SDQueryQueue));
+	memset(sd_query_direct_stream_active, 0, sizeof(sd_query_direct_stream_active));
+}
+
+void sd_query_tick(void) {
+	// The next query starts as soon as the last callback of the previous one is handed over
+	if(!sd_query.active && !sd_query.new_cb) {
+		if((sd_query_queue.count == 0) || sd_query_is_direct_stream_active(sd_query_queue.request[sd_query_queue.start].data_type)) {
+			return;
+		}
+
+		sd_query_begin(&sd_query_queue.request[sd_query_queue.start]);
+		sd_query_queue.start = (sd_query_queue.start + 1) % SD_QUERY_QUEUE_LENGTH;
+		sd_query_queue.count--;
+	}
+
+	if(!sd_query.active) {
+		return;
+	}
+
+	if(sd_query.part_active) {
+		if(sd_query.part_padding) {
+			sd_query_pad_part();
+		} else {
+			sd_query_read_part();
+		}
+	} else if((sd_query.slots_left > 0) && !sd_query_is_sd_query_pending(sd_query.data_type) && !sd_query_is_direct_stream_active(sd_query.data_type)) {
+		sd_query_next_part();
+	}
+
+	sd_query_fill_cb();
+}
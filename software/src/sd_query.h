@@ -0,0 +1,126 @@
+/* warp-energy-manager-v2-bricklet
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * sd_query.h: Range queries over SD data points
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef SD_QUERY_H
+#define SD_QUERY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "sd_codec.h"
+#include "sd_data_point.h"
+
+// Has to hold one aggregation bucket (142 bytes) in addition to less
+// than one callback chunk
+#define SD_QUERY_BUFFER_SIZE 200
+#define SD_QUERY_CB_LENGTH 54
+#define SD_QUERY_CB_COMPRESSED_LENGTH 53
+#define SD_QUERY_PART_TIMEOUT 2000 // ms
+
+#define SD_QUERY_QUEUE_LENGTH 4
+
+#define SD_QUERY_5MIN_SLOTS_PER_DAY (24*12)
+
+typedef struct {
+	uint8_t year;
+	uint8_t month;
+	uint8_t day;
+	uint8_t hour;
+	uint8_t minute;
+} SDQueryDate;
+
+typedef struct {
+	uint8_t request_id;
+	uint8_t data_type;
+	uint32_t wallbox_id;
+	SDQueryDate start;
+	SDQueryDate end; // exclusive
+	bool compress;
+	bool aggregate;
+	uint8_t interval;
+} SDQueryRequest;
+
+typedef struct {
+	SDQueryRequest request[SD_QUERY_QUEUE_LENGTH];
+	uint8_t start;
+	uint8_t count;
+	uint8_t next_request_id;
+} SDQueryQueue;
+
+typedef struct {
+	bool active;
+	uint8_t status; // Set if the query was aborted
+	uint8_t request_id;
+	bool aggregate;
+	bool compress;
+	uint8_t data_type;
+	uint32_t wallbox_id;
+
+	// Range that is not yet requested from the SD card
+	SDQueryDate date;
+	uint32_t slots_left;
+
+	// One part is one day (5 minute data) or one month (daily data)
+	bool part_active;
+	bool part_padding;
+	uint32_t part_length;   // bytes
+	uint32_t part_received; // bytes
+	uint32_t part_time;
+	uint32_t chunk_used;    // bytes of the current SD callback chunk
+
+	// Compressed streams: Runs of unchanged data points are only counted
+	SDCodec codec;
+	uint8_t data_point[SD_DATA_POINT_SIZE_MAX];
+	uint8_t data_point_used;
+	uint32_t run;
+	bool run_flushed;
+
+	// For compressed streams data_length is the uncompressed length and
+	// data_offset counts the compressed bytes
+	uint32_t data_length;
+	uint32_t data_offset;
+	uint8_t buffer[SD_QUERY_BUFFER_SIZE];
+	uint16_t buffer_used;
+
+	bool new_cb;
+	uint8_t cb_status;
+	uint32_t cb_data_length;
+	uint32_t cb_offset;
+	uint8_t cb_chunk_length;
+	uint8_t cb_data[SD_QUERY_CB_LENGTH];
+} SDQuery;
+
+extern SDQuery sd_query;
+extern SDQueryQueue sd_query_queue;
+
+uint8_t sd_query_days_in_month(const uint8_t year, const uint8_t month);
+uint32_t sd_query_get_slot(const uint8_t data_type, const SDQueryDate *date);
+bool sd_query_get_date(const uint8_t data_type, const uint32_t slot, SDQueryDate *date);
+uint8_t sd_query_request(SDQueryRequest *request);
+bool sd_query_is_queue_full(void);
+bool sd_query_is_active(const uint8_t data_type);
+void sd_query_direct_stream_begin(const uint8_t data_type);
+void sd_query_direct_stream_chunk(const uint8_t data_type, const uint32_t offset, const uint32_t length, const uint32_t chunk_length);
+bool sd_query_is_direct_stream_active(const uint8_t data_type);
+void sd_query_init(void);
+void sd_query_tick(void);
+
+#endif
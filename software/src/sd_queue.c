@@ -0,0 +1,100 @@
+/* warp-energy-manager-v2-bricklet
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * sd_queue.c: Ringbuffer queues in front of the SD data point queues
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#include "sd_queue.h"
+
+#include <string.h>
+
+#include "sd.h"
+#include "sd_statistics.h"
+
+SDQueue sd_queue;
+
+static const uint8_t sd_queue_data_point_size[SD_QUEUE_NUM] = {
+	SD_QUEUE_WALLBOX_DATA_POINT_SIZE,
+	SD_QUEUE_WALLBOX_DAILY_DATA_POINT_SIZE,
+	SD_QUEUE_ENERGY_MANAGER_DATA_POINT_SIZE,
+	SD_QUEUE_ENERGY_MANAGER_DAILY_DATA_POINT_SIZE
+};
+
+bool sd_queue_add(const SDQueueType type, const void *data_point) {
+	Ringbuffer *rb = &sd_queue.rb[type];
+	const uint8_t size = sd_queue_data_point_size[type];
+	if(ringbuffer_get_free(rb) < size) {
+		return false;
+	}
+
+	const uint8_t *data = data_point;
+	for(uint8_t i = 0; i < size; i++) {
+		ringbuffer_add(rb, data[i]);
+	}
+
+	sd_statistics_update_queue(type, ringbuffer_get_used(rb) / size);
+
+	return true;
+}
+
+static bool sd_queue_get(const SDQueueType type, void *data_point) {
+	Ringbuffer *rb = &sd_queue.rb[type];
+	const uint8_t size = sd_queue_data_point_size[type];
+	if(ringbuffer_get_used(rb) < size) {
+		return false;
+	}
+
+	uint8_t *data = data_point;
+	for(uint8_t i = 0; i < size; i++) {
+		ringbuffer_get(rb, &data[i]);
+	}
+
+	return true;
+}
+
+uint16_t sd_queue_get_free(const SDQueueType type) {
+	return ringbuffer_get_free(&sd_queue.rb[type]) / sd_queue_data_point_size[type];
+}
+
+void sd_queue_init(void) {
+	memset(&sd_queue, 0, sizeof(SDQueue));
+
+	ringbuffer_init(&sd_queue.rb[SD_QUEUE_WALLBOX_DATA_POINT],               sizeof(sd_queue.wallbox_data_point_buffer),               sd_queue.wallbox_data_point_buffer);
+	ringbuffer_init(&sd_queue.rb[SD_QUEUE_WALLBOX_DAILY_DATA_POINT],         sizeof(sd_queue.wallbox_daily_data_point_buffer),         sd_queue.wallbox_daily_data_point_buffer);
+	ringbuffer_init(&sd_queue.rb[SD_QUEUE_ENERGY_MANAGER_DATA_POINT],        sizeof(sd_queue.energy_manager_data_point_buffer),        sd_queue.energy_manager_data_point_buffer);
+	ringbuffer_init(&sd_queue.rb[SD_QUEUE_ENERGY_MANAGER_DAILY_DATA_POINT],  sizeof(sd_queue.energy_manager_daily_data_point_buffer),  sd_queue.energy_manager_daily_data_point_buffer);
+}
+
+void sd_queue_tick(void) {
+	// Move data points into the SD queues as soon as the SD task has made room
+	while((sd.wallbox_data_point_end < SD_WALLBOX_DATA_POINT_LENGTH) && sd_queue_get(SD_QUEUE_WALLBOX_DATA_POINT, &sd.wallbox_data_point[sd.wallbox_data_point_end])) {
+		sd.wallbox_data_point_end++;
+	}
+
+	while((sd.wallbox_daily_data_point_end < SD_WALLBOX_DAILY_DATA_POINT_LENGTH) && sd_queue_get(SD_QUEUE_WALLBOX_DAILY_DATA_POINT, &sd.wallbox_daily_data_point[sd.wallbox_daily_data_point_end])) {
+		sd.wallbox_daily_data_point_end++;
+	}
+
+	while((sd.energy_manager_data_point_end < SD_ENERGY_MANAGER_DATA_POINT_LENGTH) && sd_queue_get(SD_QUEUE_ENERGY_MANAGER_DATA_POINT, &sd.energy_manager_data_point[sd.energy_manager_data_point_end])) {
+		sd.energy_manager_data_point_end++;
+	}
+
+	while((sd.energy_manager_daily_data_point_end < SD_ENERGY_MANAGER_DAILY_DATA_POINT_LENGTH) && sd_queue_get(SD_QUEUE_ENERGY_MANAGER_DAILY_DATA_POINT, &sd.energy_manager_daily_data_point[sd.energy_manager_daily_data_point_end])) {
+		sd.energy_manager_daily_data_point_end++;
+	}
+}
@@ -0,0 +1,72 @@
+/* warp-energy-manager-v2-bricklet
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * sd_queue.h: Ringbuffer queues in front of the SD data point queues
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef SD_QUEUE_H
+#define SD_QUEUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "bricklib2/utility/ringbuffer.h"
+
+#include "communication.h"
+
+// Number of data points that can be queued in RAM in addition to the SD queues.
+// The host paces its writes with get_sd_queue_status, so these only have to
+// cover a short burst. The energy manager writes one data point per type
+// every 5 minutes or once a day.
+#define SD_QUEUE_WALLBOX_DATA_POINT_NUM               16
+#define SD_QUEUE_WALLBOX_DAILY_DATA_POINT_NUM         4
+#define SD_QUEUE_ENERGY_MANAGER_DATA_POINT_NUM        2
+#define SD_QUEUE_ENERGY_MANAGER_DAILY_DATA_POINT_NUM  2
+
+// Data points are stored as the payload of the corresponding set function
+#define SD_QUEUE_WALLBOX_DATA_POINT_SIZE              (sizeof(SetSDWallboxDataPoint) - sizeof(TFPMessageHeader))
+#define SD_QUEUE_WALLBOX_DAILY_DATA_POINT_SIZE        (sizeof(SetSDWallboxDailyDataPoint) - sizeof(TFPMessageHeader))
+#define SD_QUEUE_ENERGY_MANAGER_DATA_POINT_SIZE       (sizeof(SetSDEnergyManagerDataPoint) - sizeof(TFPMessageHeader))
+#define SD_QUEUE_ENERGY_MANAGER_DAILY_DATA_POINT_SIZE (sizeof(SetSDEnergyManagerDailyDataPoint) - sizeof(TFPMessageHeader))
+
+typedef enum {
+	SD_QUEUE_WALLBOX_DATA_POINT = 0,
+	SD_QUEUE_WALLBOX_DAILY_DATA_POINT,
+	SD_QUEUE_ENERGY_MANAGER_DATA_POINT,
+	SD_QUEUE_ENERGY_MANAGER_DAILY_DATA_POINT,
+	SD_QUEUE_NUM
+} SDQueueType;
+
+typedef struct {
+	Ringbuffer rb[SD_QUEUE_NUM];
+
+	// Ringbuffer keeps one byte free to distinguish between full and empty
+	uint8_t wallbox_data_point_buffer[SD_QUEUE_WALLBOX_DATA_POINT_NUM*SD_QUEUE_WALLBOX_DATA_POINT_SIZE + 1];
+	uint8_t wallbox_daily_data_point_buffer[SD_QUEUE_WALLBOX_DAILY_DATA_POINT_NUM*SD_QUEUE_WALLBOX_DAILY_DATA_POINT_SIZE + 1];
+	uint8_t energy_manager_data_point_buffer[SD_QUEUE_ENERGY_MANAGER_DATA_POINT_NUM*SD_QUEUE_ENERGY_MANAGER_DATA_POINT_SIZE + 1];
+	uint8_t energy_manager_daily_data_point_buffer[SD_QUEUE_ENERGY_MANAGER_DAILY_DATA_POINT_NUM*SD_QUEUE_ENERGY_MANAGER_DAILY_DATA_POINT_SIZE + 1];
+} SDQueue;
+
+extern SDQueue sd_queue;
+
+bool sd_queue_add(const SDQueueType type, const void *data_point);
+uint16_t sd_queue_get_free(const SDQueueType type);
+void sd_queue_init(void);
+void sd_queue_tick(void);
+
+#endif
@@ -0,0 +1,68 @@
+/* warp-energy-manager-v2-bricklet
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * sd_statistics.c: SD task and SD queue statistics
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#include "sd_statistics.h"
+
+#include <string.h>
+
+#include "bricklib2/hal/system_timer/system_timer.h"
+
+SDStatistics sd_statistics;
+
+static const uint8_t sd_statistics_histogram_limit[SD_STATISTICS_HISTOGRAM_NUM - 1] = {
+	1, 2, 5, 10, 20, 50, 100
+};
+
+void sd_statistics_update_tick(const uint32_t start) {
+	const uint32_t duration = system_timer_get_ms() - start;
+
+	if((sd_statistics.tick_count == 0) || (duration < sd_statistics.tick_min)) {
+		sd_statistics.tick_min = duration;
+	}
+	if(duration > sd_statistics.tick_max) {
+		sd_statistics.tick_max = duration;
+	}
+
+	sd_statistics.tick_count++;
+	sd_statistics.tick_sum += duration;
+
+	uint8_t bucket = 0;
+	while((bucket < SD_STATISTICS_HISTOGRAM_NUM - 1) && (duration >= sd_statistics_histogram_limit[bucket])) {
+		bucket++;
+	}
+	sd_statistics.tick_histogram[bucket]++;
+}
+
+void sd_statistics_update_queue(const SDQueueType type, const uint16_t used) {
+	if(used > sd_statistics.queue_high_water[type]) {
+		sd_statistics.queue_high_water[type] = used;
+	}
+}
+
+void sd_statistics_queue_full(const SDQueueType type) {
+	if(sd_statistics.queue_full[type] < UINT16_MAX) {
+		sd_statistics.queue_full[type]++;
+	}
+}
+
+void sd_statistics_init(void) {
+	memset(&sd_statistics, 0, sizeof(SDStatistics));
+}
@@ -0,0 +1,51 @@
+/* warp-energy-manager-v2-bricklet
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * sd_statistics.h: SD task and SD queue statistics
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef SD_STATISTICS_H
+#define SD_STATISTICS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "sd_queue.h"
+
+// sd_tick durations are sorted into buckets of < 1, 2, 5, 10, 20, 50, 100 and >= 100 ms
+#define SD_STATISTICS_HISTOGRAM_NUM 8
+
+typedef struct {
+	uint32_t tick_count;
+	uint32_t tick_sum; // ms
+	uint32_t tick_min; // ms
+	uint32_t tick_max; // ms
+	uint32_t tick_histogram[SD_STATISTICS_HISTOGRAM_NUM];
+
+	uint16_t queue_high_water[SD_QUEUE_NUM]; // data points
+	uint16_t queue_full[SD_QUEUE_NUM];       // rejected data points
+} SDStatistics;
+
+extern SDStatistics sd_statistics;
+
+void sd_statistics_update_tick(const uint32_t start);
+void sd_statistics_update_queue(const SDQueueType type, const uint16_t used);
+void sd_statistics_queue_full(const SDQueueType type);
+void sd_statistics_init(void);
+
+#endif
@@ -0,0 +1,42 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+HOST = 'localhost'
+PORT = 4223
+EM_UID = '2kUNJR'
+
+from tinkerforge.ip_connection import IPConnection, Error
+from tinkerforge.bricklet_warp_energy_manager_v2 import BrickletWARPEnergyManagerV2
+
+PAGE_SIZE = 63
+
+if __name__ == '__main__':
+    ipcon = IPConnection()
+    ipcon.connect(HOST, PORT)
+    em = BrickletWARPEnergyManagerV2(EM_UID, ipcon)
+
+    # Get and set use the same records: Status byte followed by the page data.
+    # The status byte is ignored by set_data_storage_pages.
+    pages = em.get_data_storage_pages()
+    for i in range(0, len(pages), PAGE_SIZE + 1):
+        print('page {0}: status {1}, {2}'.format(i // (PAGE_SIZE + 1), pages[i], pages[i+1:i+1+PAGE_SIZE]))
+
+    # Write all pages at once, starting with page 0
+    data = []
+    for i in range(len(pages) // (PAGE_SIZE + 1)):
+        data += [0] + [(i + j) % 256 for j in range(PAGE_SIZE)]
+
+    print(em.set_data_storage_pages(data))
+
+    # A get that is abandoned halfway does not affect the next one
+    em.get_data_storage_pages_low_level(60)
+    pages = em.get_data_storage_pages()
+    for i in range(0, len(pages), PAGE_SIZE + 1):
+        assert pages[i+1:i+1+PAGE_SIZE] == data[i+1:i+1+PAGE_SIZE]
+
+    # Only whole records can be written
+    try:
+        em.set_data_storage_pages(data[:PAGE_SIZE])
+        assert False
+    except Error as e:
+        assert e.value == Error.INVALID_PARAMETER
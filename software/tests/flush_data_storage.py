@@ -0,0 +1,29 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+HOST = 'localhost'
+PORT = 4223
+EM_UID = '2kUNJR'
+
+import time
+
+from tinkerforge.ip_connection import IPConnection
+from tinkerforge.bricklet_warp_energy_manager_v2 import BrickletWARPEnergyManagerV2
+
+if __name__ == '__main__':
+    ipcon = IPConnection()
+    ipcon.connect(HOST, PORT)
+    em = BrickletWARPEnergyManagerV2(EM_UID, ipcon)
+
+    # Page 0 is written to SD 30s after a change instead of 10 minutes
+    em.set_data_storage_flush_delay(0, 30)
+    print('delay page 0: {0}s'.format(em.get_data_storage_flush_delay(0)))
+
+    em.set_data_storage(1, list(range(63)))
+    print('dirty pages: {0:05b}'.format(em.get_data_storage_status()))
+
+    # Write all changed pages now, e.g. before a planned restart
+    em.flush_data_storage()
+    while em.get_data_storage_status() != 0:
+        time.sleep(0.1)
+    print('dirty pages: {0:05b}'.format(em.get_data_storage_status()))
@@ -0,0 +1,47 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+HOST = 'localhost'
+PORT = 4223
+EM_UID = '2kUNJR'
+
+import struct
+import time
+from collections import namedtuple
+
+from tinkerforge.ip_connection import IPConnection
+from tinkerforge.bricklet_warp_energy_manager_v2 import BrickletWARPEnergyManagerV2
+
+# One bucket per interval: count, then sum, min, max and avg for
+# power_grid and power_general[6]. Data points with all values at zero
+# are treated as missing and are not counted.
+BUCKET_FORMAT = '<H 7q 7i 7i 7i'
+Bucket = namedtuple('Bucket', ['count', 'sum', 'min', 'max', 'avg'])
+
+done = False
+
+def cb_sd_data_points_range(request_id, status, data):
+    global done
+    if status != BrickletWARPEnergyManagerV2.DATA_STATUS_OK:
+        print('query aborted with status {0}'.format(status))
+
+    data = bytes(data)
+    size = struct.calcsize(BUCKET_FORMAT)
+    for i in range(0, len(data) - len(data) % size, size):
+        values = struct.unpack_from(BUCKET_FORMAT, data, i)
+        bucket = Bucket(values[0], values[1:8], values[8:15], values[15:22], values[22:29])
+        print(bucket)
+    done = True
+
+if __name__ == '__main__':
+    ipcon = IPConnection()
+    ipcon.connect(HOST, PORT)
+    em = BrickletWARPEnergyManagerV2(EM_UID, ipcon)
+    em.register_callback(em.CALLBACK_SD_DATA_POINTS_RANGE, cb_sd_data_points_range)
+
+    # Hourly averages of one day, end is exclusive
+    ret = em.get_sd_energy_manager_data_points_aggregated(em.AGGREGATION_INTERVAL_HOUR, 25, 1, 1, 0, 25, 1, 2, 0)
+    print('status {0}, request {1}'.format(ret.status, ret.request_id))
+
+    while ret.status == em.DATA_STATUS_OK and not done:
+        time.sleep(0.1)
@@ -0,0 +1,65 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+HOST = 'localhost'
+PORT = 4223
+EM_UID = '2kUNJR'
+
+import struct
+import time
+
+from tinkerforge.ip_connection import IPConnection
+from tinkerforge.bricklet_warp_energy_manager_v2 import BrickletWARPEnergyManagerV2
+from tinkerforge.sd_codec import SDCodecDecoder
+
+# Record layout in the range stream per data type
+RECORD_FORMAT = {
+    BrickletWARPEnergyManagerV2.DATA_TYPE_WALLBOX:              '<H H',
+    BrickletWARPEnergyManagerV2.DATA_TYPE_WALLBOX_DAILY:        '<I',
+    BrickletWARPEnergyManagerV2.DATA_TYPE_ENERGY_MANAGER:       '<H i 6i I',
+    BrickletWARPEnergyManagerV2.DATA_TYPE_ENERGY_MANAGER_DAILY: '<15I',
+}
+
+compress = True
+requests = {} # request_id -> [data_type, decoder, frames]
+
+# A status other than DATA_STATUS_OK means that the query was aborted
+# (SD error, littlefs error or timeout). data then ends where the query
+# was aborted.
+def cb_sd_data_points_range(request_id, status, data):
+    if request_id not in requests:
+        return
+
+    data_type, _, frames = requests.pop(request_id)
+    data = bytes(data)
+    size = struct.calcsize(RECORD_FORMAT[data_type])
+    records = [struct.unpack_from(RECORD_FORMAT[data_type], data, i) for i in range(0, len(data) - len(data) % size, size)]
+    print('request {0}: status {1}, {2} records, {3} bytes, {4} frames in {5:.2f}s'.format(request_id, status, len(records), len(data), frames, time.time() - start))
+
+def cb_sd_data_points_range_compressed_low_level(request_id, status, data_length, data_chunk_offset, data_chunk_length, data_chunk_data):
+    if request_id not in requests:
+        return
+
+    requests[request_id][2] += 1
+    data = requests[request_id][1].feed(status, data_length, data_chunk_offset, data_chunk_length, data_chunk_data)
+    if data is not None:
+        cb_sd_data_points_range(request_id, status, data)
+
+if __name__ == '__main__':
+    ipcon = IPConnection()
+    ipcon.connect(HOST, PORT)
+    em = BrickletWARPEnergyManagerV2(EM_UID, ipcon)
+    em.register_callback(em.CALLBACK_SD_DATA_POINTS_RANGE, cb_sd_data_points_range)
+    em.register_callback(em.CALLBACK_SD_DATA_POINTS_RANGE_COMPRESSED_LOW_LEVEL, cb_sd_data_points_range_compressed_low_level)
+
+    # One week of 5 minute data for the energy manager and one wallbox,
+    # both queries are queued back-to-back. End is exclusive.
+    start = time.time()
+    for data_type, wallbox_id in [(em.DATA_TYPE_ENERGY_MANAGER, 0), (em.DATA_TYPE_WALLBOX, 1)]:
+        ret = em.get_sd_data_points_range(data_type, wallbox_id, 25, 1, 1, 0, 0, 25, 1, 8, 0, 0, compress)
+        print('status {0}, request {1}'.format(ret.status, ret.request_id))
+        if ret.status == em.DATA_STATUS_OK:
+            requests[ret.request_id] = [data_type, SDCodecDecoder(data_type), 0]
+
+    while len(requests) > 0:
+        time.sleep(0.1)
@@ -0,0 +1,56 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+HOST = 'localhost'
+PORT = 4223
+EM_UID = '2kUNJR'
+
+import struct
+import time
+
+from tinkerforge.ip_connection import IPConnection
+from tinkerforge.bricklet_warp_energy_manager_v2 import BrickletWARPEnergyManagerV2
+
+# Packed data point layout, same as the payload of set_sd_wallbox_data_point
+WALLBOX_DATA_POINT_FORMAT = '<I B B B B B H H'
+
+def set_data_points(em, data_points):
+    data = b''.join(struct.pack(WALLBOX_DATA_POINT_FORMAT, *dp) for dp in data_points)
+    accepted = 0
+
+    while accepted < len(data_points):
+        stream = data[accepted*struct.calcsize(WALLBOX_DATA_POINT_FORMAT):]
+        offset = 0
+        while offset < len(stream):
+            chunk = list(stream[offset:offset+60])
+            chunk += [0]*(60 - len(chunk))
+            ret = em.set_sd_wallbox_data_points_low_level(len(stream), offset, chunk)
+            if ret.status != em.DATA_STATUS_OK:
+                break
+            offset += 60
+
+            # Wait for the SD card to catch up before the queue is full
+            while ret.data_points_free < 5 and em.get_sd_queue_status().wallbox_data_points_free < 5:
+                time.sleep(0.01)
+
+        accepted += ret.data_points_accepted
+        print('status {0}, accepted {1}/{2}'.format(ret.status, accepted, len(data_points)))
+
+        if ret.status == em.DATA_STATUS_QUEUE_FULL:
+            time.sleep(0.1)
+        elif ret.status != em.DATA_STATUS_OK:
+            accepted += 1 # Skip data point with invalid date
+
+if __name__ == '__main__':
+    ipcon = IPConnection()
+    ipcon.connect(HOST, PORT)
+    em = BrickletWARPEnergyManagerV2(EM_UID, ipcon)
+
+    data_points = []
+    for hour in range(24):
+        for minute in range(0, 60, 5):
+            data_points.append((1, 25, 1, 1, hour, minute, 0, hour*100 + minute))
+
+    start = time.time()
+    set_data_points(em, data_points)
+    print('{0} data points in {1:.2f}s'.format(len(data_points), time.time() - start))
@@ -0,0 +1,77 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+HOST = 'localhost'
+PORT = 4223
+EM_UID = '2kUNJR'
+
+import os
+import sys
+import time
+
+from tinkerforge.ip_connection import IPConnection
+from tinkerforge.bricklet_warp_energy_manager_v2 import BrickletWARPEnergyManagerV2
+
+# Exports the energy manager 5 minute history into a file. If the script
+# is interrupted, the next run continues after the last complete record
+# in the file.
+#
+# Usage: sd_export.py FILE [START_CURSOR]
+#
+# The cursor counts data points since 2000-01-01 00:00. The first record
+# in FILE belongs to START_CURSOR (default 0).
+DATA_TYPE = BrickletWARPEnergyManagerV2.DATA_TYPE_ENERGY_MANAGER
+RECORD_SIZE = 34
+END = (26, 1, 1) # Exclusive
+
+request_id = None
+done = False
+out = None
+
+def cb_sd_data_points_range_low_level(cb_request_id, status, data_length, data_chunk_offset, data_chunk_data):
+    global done
+    if cb_request_id != request_id:
+        return
+
+    # The data that was written so far is kept, the next run continues there
+    if status != em.DATA_STATUS_OK:
+        print('export aborted with status {0} at offset {1}, restart the export'.format(status, data_chunk_offset))
+        done = True
+        return
+
+    if data_chunk_offset != out.tell() - start_offset:
+        print('lost chunk at offset {0}, restart the export'.format(data_chunk_offset))
+        done = True
+        return
+
+    chunk = bytes(data_chunk_data[:min(len(data_chunk_data), data_length - data_chunk_offset)])
+    out.write(chunk)
+    if data_chunk_offset + len(chunk) >= data_length:
+        done = True
+
+if __name__ == '__main__':
+    path = sys.argv[1]
+    start_cursor = int(sys.argv[2]) if len(sys.argv) > 2 else 0
+
+    # Drop an incomplete record at the end of the file
+    size = os.path.getsize(path) if os.path.exists(path) else 0
+    size -= size % RECORD_SIZE
+    out = open(path, 'ab')
+    out.truncate(size)
+    out.seek(size)
+    start_offset = size
+
+    ipcon = IPConnection()
+    ipcon.connect(HOST, PORT)
+    em = BrickletWARPEnergyManagerV2(EM_UID, ipcon)
+    em.register_callback(em.CALLBACK_SD_DATA_POINTS_RANGE_LOW_LEVEL, cb_sd_data_points_range_low_level)
+
+    cursor = start_cursor + size // RECORD_SIZE
+    ret = em.get_sd_data_points_export(DATA_TYPE, 0, cursor, END[0], END[1], END[2], False)
+    print('status {0}, request {1}, cursor {2} -> {3}'.format(ret.status, ret.request_id, cursor, ret.cursor_end))
+    request_id = ret.request_id
+
+    while ret.status == em.DATA_STATUS_OK and not done:
+        time.sleep(0.1)
+
+    out.close()
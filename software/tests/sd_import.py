@@ -0,0 +1,83 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+HOST = 'localhost'
+PORT = 4223
+EM_UID = '2kUNJR'
+
+import datetime
+import itertools
+import struct
+import sys
+import time
+
+from tinkerforge.ip_connection import IPConnection
+from tinkerforge.bricklet_warp_energy_manager_v2 import BrickletWARPEnergyManagerV2
+
+# Writes an energy manager history file that was created by sd_export.py
+# back to the SD card and prints the result per day file.
+#
+# Usage: sd_import.py FILE [START_CURSOR]
+RECORD_SIZE = 34
+
+# Packed data point layout, same as the payload of set_sd_energy_manager_data_point
+DATA_POINT_SIZE = 5 + RECORD_SIZE
+EPOCH = datetime.datetime(2000, 1, 1)
+
+def set_data_points(em, stream, count):
+    # Returns number of accepted data points and status of the last chunk
+    accepted = 0
+    status = em.DATA_STATUS_OK
+
+    while accepted < count:
+        data = stream[accepted*DATA_POINT_SIZE:]
+        offset = 0
+        while offset < len(data):
+            chunk = list(data[offset:offset+60])
+            chunk += [0]*(60 - len(chunk))
+            ret = em.set_sd_energy_manager_data_points_low_level(len(data), offset, chunk)
+            if ret.status != em.DATA_STATUS_OK:
+                break
+            offset += 60
+
+            # Wait for the SD card to catch up before the queue is full
+            while ret.data_points_free < 2 and em.get_sd_queue_status().energy_manager_data_points_free < 2:
+                time.sleep(0.01)
+
+        accepted += ret.data_points_accepted
+        status = ret.status
+
+        if ret.status == em.DATA_STATUS_QUEUE_FULL:
+            time.sleep(0.1)
+        elif ret.status != em.DATA_STATUS_OK:
+            break
+
+    return accepted, status
+
+if __name__ == '__main__':
+    path = sys.argv[1]
+    start_cursor = int(sys.argv[2]) if len(sys.argv) > 2 else 0
+
+    ipcon = IPConnection()
+    ipcon.connect(HOST, PORT)
+    em = BrickletWARPEnergyManagerV2(EM_UID, ipcon)
+
+    data = open(path, 'rb').read()
+    records = []
+    for i in range(len(data) // RECORD_SIZE):
+        record = data[i*RECORD_SIZE:(i + 1)*RECORD_SIZE]
+
+        # Data points that were never written are exported as zeros
+        if record == bytes(RECORD_SIZE):
+            continue
+
+        date = EPOCH + datetime.timedelta(minutes=5*(start_cursor + i))
+        records.append((date, struct.pack('<B B B B B', date.year - 2000, date.month, date.day, date.hour, date.minute) + record))
+
+    start = time.time()
+    for day, day_records in itertools.groupby(records, key=lambda r: r[0].date()):
+        day_records = list(day_records)
+        accepted, status = set_data_points(em, b''.join(r[1] for r in day_records), len(day_records))
+        print('{0}: {1}/{2} data points, status {3}'.format(day, accepted, len(day_records), status))
+
+    print('{0} data points in {1:.2f}s'.format(len(records), time.time() - start))
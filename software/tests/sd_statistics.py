@@ -0,0 +1,31 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+HOST = 'localhost'
+PORT = 4223
+EM_UID = '2kUNJR'
+
+import time
+
+from tinkerforge.ip_connection import IPConnection
+from tinkerforge.bricklet_warp_energy_manager_v2 import BrickletWARPEnergyManagerV2
+
+HISTOGRAM_BUCKETS = ['<1ms', '<2ms', '<5ms', '<10ms', '<20ms', '<50ms', '<100ms', '>=100ms']
+QUEUES = ['wallbox', 'wallbox daily', 'energy manager', 'energy manager daily']
+
+if __name__ == '__main__':
+    ipcon = IPConnection()
+    ipcon.connect(HOST, PORT)
+    em = BrickletWARPEnergyManagerV2(EM_UID, ipcon)
+
+    # Statistics are reset on every call
+    em.get_sd_statistics()
+
+    while True:
+        time.sleep(10)
+        stats = em.get_sd_statistics()
+
+        print('sd_tick min/avg/max: {0}/{1}/{2} ms'.format(stats.sd_tick_min, stats.sd_tick_avg, stats.sd_tick_max))
+        print('  ' + ', '.join('{0}: {1}'.format(bucket, count) for bucket, count in zip(HISTOGRAM_BUCKETS, stats.sd_tick_histogram)))
+        for name, high_water, full in zip(QUEUES, stats.queue_high_water, stats.queue_full):
+            print('  {0} queue: high water {1}, full {2}'.format(name, high_water, full))
@@ -26,6 +26,17 @@ GetAllData1 = namedtuple('AllData1', ['power', 'current', 'energy_meter_type', '
 GetSDInformation = namedtuple('SDInformation', ['sd_status', 'lfs_status', 'sector_size', 'sector_count', 'card_type', 'product_rev', 'product_name', 'manufacturer_id'])
 GetDateTime = namedtuple('DateTime', ['seconds', 'minutes', 'hours', 'days', 'days_of_week', 'month', 'year'])
 GetDataStorage = namedtuple('DataStorage', ['status', 'data'])
+SetSDWallboxDataPointsLowLevel = namedtuple('SetSDWallboxDataPointsLowLevel', ['status', 'data_points_accepted', 'data_points_free'])
+SetSDEnergyManagerDataPointsLowLevel = namedtuple('SetSDEnergyManagerDataPointsLowLevel', ['status', 'data_points_accepted', 'data_points_free'])
+GetSDQueueStatus = namedtuple('SDQueueStatus', ['wallbox_data_points_free', 'wallbox_daily_data_points_free', 'energy_manager_data_points_free', 'energy_manager_daily_data_points_free'])
+GetSDDataPointsRange = namedtuple('SDDataPointsRange', ['status', 'request_id'])
+GetSDEnergyManagerDataPointsAggregated = namedtuple('SDEnergyManagerDataPointsAggregated', ['status', 'request_id'])
+GetSDDataPointsExport = namedtuple('SDDataPointsExport', ['status', 'request_id', 'cursor_end'])
+SetSDWallboxDailyDataPointsLowLevel = namedtuple('SetSDWallboxDailyDataPointsLowLevel', ['status', 'data_points_accepted', 'data_points_free'])
+SetSDEnergyManagerDailyDataPointsLowLevel = namedtuple('SetSDEnergyManagerDailyDataPointsLowLevel', ['status', 'data_points_accepted', 'data_points_free'])
+GetDataStoragePagesLowLevel = namedtuple('DataStoragePagesLowLevel', ['pages_length', 'pages_chunk_offset', 'pages_chunk_data'])
+SetDataStoragePagesLowLevel = namedtuple('SetDataStoragePagesLowLevel', ['status', 'pages_accepted'])
+GetSDStatistics = namedtuple('SDStatistics', ['sd_tick_min', 'sd_tick_avg', 'sd_tick_max', 'sd_tick_histogram', 'queue_high_water', 'queue_full'])
 GetSPITFPErrorCount = namedtuple('SPITFPErrorCount', ['error_count_ack_checksum', 'error_count_message_checksum', 'error_count_frame', 'error_count_overflow'])
 GetIdentity = namedtuple('Identity', ['uid', 'connected_uid', 'position', 'hardware_version', 'firmware_version', 'device_identifier'])
 
@@ -42,11 +53,14 @@ class BrickletWARPEnergyManagerV2(Device):
     CALLBACK_SD_WALLBOX_DAILY_DATA_POINTS_LOW_LEVEL = 22
     CALLBACK_SD_ENERGY_MANAGER_DATA_POINTS_LOW_LEVEL = 23
     CALLBACK_SD_ENERGY_MANAGER_DAILY_DATA_POINTS_LOW_LEVEL = 24
+    CALLBACK_SD_DATA_POINTS_RANGE_LOW_LEVEL = 36
+    CALLBACK_SD_DATA_POINTS_RANGE_COMPRESSED_LOW_LEVEL = 38
 
     CALLBACK_SD_WALLBOX_DATA_POINTS = -21
     CALLBACK_SD_WALLBOX_DAILY_DATA_POINTS = -22
     CALLBACK_SD_ENERGY_MANAGER_DATA_POINTS = -23
     CALLBACK_SD_ENERGY_MANAGER_DAILY_DATA_POINTS = -24
+    CALLBACK_SD_DATA_POINTS_RANGE = -36
 
     FUNCTION_GET_ENERGY_METER_VALUES = 1
     FUNCTION_GET_ENERGY_METER_DETAILED_VALUES_LOW_LEVEL = 2
@@ -74,6 +88,22 @@ class BrickletWARPEnergyManagerV2(Device):
     FUNCTION_GET_DATA_STORAGE = 28
     FUNCTION_SET_DATA_STORAGE = 29
     FUNCTION_RESET_ENERGY_METER_RELATIVE_ENERGY = 30
+    FUNCTION_SET_SD_WALLBOX_DATA_POINTS_LOW_LEVEL = 31
+    FUNCTION_SET_SD_ENERGY_MANAGER_DATA_POINTS_LOW_LEVEL = 32
+    FUNCTION_GET_SD_QUEUE_STATUS = 33
+    FUNCTION_GET_MAIN_LOOP_LATENCY = 34
+    FUNCTION_GET_SD_DATA_POINTS_RANGE = 35
+    FUNCTION_GET_SD_ENERGY_MANAGER_DATA_POINTS_AGGREGATED = 37
+    FUNCTION_GET_SD_DATA_POINTS_EXPORT = 40
+    FUNCTION_SET_SD_WALLBOX_DAILY_DATA_POINTS_LOW_LEVEL = 41
+    FUNCTION_SET_SD_ENERGY_MANAGER_DAILY_DATA_POINTS_LOW_LEVEL = 42
+    FUNCTION_SET_DATA_STORAGE_FLUSH_DELAY = 43
+    FUNCTION_GET_DATA_STORAGE_FLUSH_DELAY = 44
+    FUNCTION_FLUSH_DATA_STORAGE = 45
+    FUNCTION_GET_DATA_STORAGE_STATUS = 46
+    FUNCTION_GET_DATA_STORAGE_PAGES_LOW_LEVEL = 47
+    FUNCTION_SET_DATA_STORAGE_PAGES_LOW_LEVEL = 48
+    FUNCTION_GET_SD_STATISTICS = 49
     FUNCTION_GET_SPITFP_ERROR_COUNT = 234
     FUNCTION_SET_BOOTLOADER_MODE = 235
     FUNCTION_GET_BOOTLOADER_MODE = 236
@@ -100,6 +130,15 @@ class BrickletWARPEnergyManagerV2(Device):
     DATA_STATUS_LFS_ERROR = 2
     DATA_STATUS_QUEUE_FULL = 3
     DATA_STATUS_DATE_OUT_OF_RANGE = 4
+    DATA_STATUS_STREAM_OUT_OF_SYNC = 5
+    DATA_STATUS_TIMEOUT = 6
+    DATA_TYPE_WALLBOX = 0
+    DATA_TYPE_WALLBOX_DAILY = 1
+    DATA_TYPE_ENERGY_MANAGER = 2
+    DATA_TYPE_ENERGY_MANAGER_DAILY = 3
+    AGGREGATION_INTERVAL_HOUR = 0
+    AGGREGATION_INTERVAL_DAY = 1
+    AGGREGATION_INTERVAL_MONTH = 2
     FORMAT_STATUS_OK = 0
     FORMAT_STATUS_PASSWORD_ERROR = 1
     FORMAT_STATUS_FORMAT_ERROR = 2
@@ -161,6 +200,22 @@ class BrickletWARPEnergyManagerV2(Device):
         self.response_expected[BrickletWARPEnergyManagerV2.FUNCTION_GET_DATA_STORAGE] = BrickletWARPEnergyManagerV2.RESPONSE_EXPECTED_ALWAYS_TRUE
         self.response_expected[BrickletWARPEnergyManagerV2.FUNCTION_SET_DATA_STORAGE] = BrickletWARPEnergyManagerV2.RESPONSE_EXPECTED_FALSE
         self.response_expected[BrickletWARPEnergyManagerV2.FUNCTION_RESET_ENERGY_METER_RELATIVE_ENERGY] = BrickletWARPEnergyManagerV2.RESPONSE_EXPECTED_FALSE
+        self.response_expected[BrickletWARPEnergyManagerV2.FUNCTION_SET_SD_WALLBOX_DATA_POINTS_LOW_LEVEL] = BrickletWARPEnergyManagerV2.RESPONSE_EXPECTED_ALWAYS_TRUE
+        self.response_expected[BrickletWARPEnergyManagerV2.FUNCTION_SET_SD_ENERGY_MANAGER_DATA_POINTS_LOW_LEVEL] = BrickletWARPEnergyManagerV2.RESPONSE_EXPECTED_ALWAYS_TRUE
+        self.response_expected[BrickletWARPEnergyManagerV2.FUNCTION_GET_SD_QUEUE_STATUS] = BrickletWARPEnergyManagerV2.RESPONSE_EXPECTED_ALWAYS_TRUE
+        self.response_expected[BrickletWARPEnergyManagerV2.FUNCTION_GET_MAIN_LOOP_LATENCY] = BrickletWARPEnergyManagerV2.RESPONSE_EXPECTED_ALWAYS_TRUE
+        self.response_expected[BrickletWARPEnergyManagerV2.FUNCTION_GET_SD_DATA_POINTS_RANGE] = BrickletWARPEnergyManagerV2.RESPONSE_EXPECTED_ALWAYS_TRUE
+        self.response_expected[BrickletWARPEnergyManagerV2.FUNCTION_GET_SD_ENERGY_MANAGER_DATA_POINTS_AGGREGATED] = BrickletWARPEnergyManagerV2.RESPONSE_EXPECTED_ALWAYS_TRUE
+        self.response_expected[BrickletWARPEnergyManagerV2.FUNCTION_GET_SD_DATA_POINTS_EXPORT] = BrickletWARPEnergyManagerV2.RESPONSE_EXPECTED_ALWAYS_TRUE
+        self.response_expected[BrickletWARPEnergyManagerV2.FUNCTION_SET_SD_WALLBOX_DAILY_DATA_POINTS_LOW_LEVEL] = BrickletWARPEnergyManagerV2.RESPONSE_EXPECTED_ALWAYS_TRUE
+        self.response_expected[BrickletWARPEnergyManagerV2.FUNCTION_SET_SD_ENERGY_MANAGER_DAILY_DATA_POINTS_LOW_LEVEL] = BrickletWARPEnergyManagerV2.RESPONSE_EXPECTED_ALWAYS_TRUE
+        self.response_expected[BrickletWARPEnergyManagerV2.FUNCTION_SET_DATA_STORAGE_FLUSH_DELAY] = BrickletWARPEnergyManagerV2.RESPONSE_EXPECTED_FALSE
+        self.response_expected[BrickletWARPEnergyManagerV2.FUNCTION_GET_DATA_STORAGE_FLUSH_DELAY] = BrickletWARPEnergyManagerV2.RESPONSE_EXPECTED_ALWAYS_TRUE
+        self.response_expected[BrickletWARPEnergyManagerV2.FUNCTION_FLUSH_DATA_STORAGE] = BrickletWARPEnergyManagerV2.RESPONSE_EXPECTED_FALSE
+        self.response_expected[BrickletWARPEnergyManagerV2.FUNCTION_GET_DATA_STORAGE_STATUS] = BrickletWARPEnergyManagerV2.RESPONSE_EXPECTED_ALWAYS_TRUE
+        self.response_expected[BrickletWARPEnergyManagerV2.FUNCTION_GET_DATA_STORAGE_PAGES_LOW_LEVEL] = BrickletWARPEnergyManagerV2.RESPONSE_EXPECTED_ALWAYS_TRUE
+        self.response_expected[BrickletWARPEnergyManagerV2.FUNCTION_SET_DATA_STORAGE_PAGES_LOW_LEVEL] = BrickletWARPEnergyManagerV2.RESPONSE_EXPECTED_ALWAYS_TRUE
+        self.response_expected[BrickletWARPEnergyManagerV2.FUNCTION_GET_SD_STATISTICS] = BrickletWARPEnergyManagerV2.RESPONSE_EXPECTED_ALWAYS_TRUE
         self.response_expected[BrickletWARPEnergyManagerV2.FUNCTION_GET_SPITFP_ERROR_COUNT] = BrickletWARPEnergyManagerV2.RESPONSE_EXPECTED_ALWAYS_TRUE
         self.response_expected[BrickletWARPEnergyManagerV2.FUNCTION_SET_BOOTLOADER_MODE] = BrickletWARPEnergyManagerV2.RESPONSE_EXPECTED_ALWAYS_TRUE
         self.response_expected[BrickletWARPEnergyManagerV2.FUNCTION_GET_BOOTLOADER_MODE] = BrickletWARPEnergyManagerV2.RESPONSE_EXPECTED_ALWAYS_TRUE
@@ -178,11 +233,14 @@ class BrickletWARPEnergyManagerV2(Device):
         self.callback_formats[BrickletWARPEnergyManagerV2.CALLBACK_SD_WALLBOX_DAILY_DATA_POINTS_LOW_LEVEL] = (72, 'H H 15I')
         self.callback_formats[BrickletWARPEnergyManagerV2.CALLBACK_SD_ENERGY_MANAGER_DATA_POINTS_LOW_LEVEL] = (46, 'H H 34B')
         self.callback_formats[BrickletWARPEnergyManagerV2.CALLBACK_SD_ENERGY_MANAGER_DAILY_DATA_POINTS_LOW_LEVEL] = (72, 'H H 15I')
+        self.callback_formats[BrickletWARPEnergyManagerV2.CALLBACK_SD_DATA_POINTS_RANGE_LOW_LEVEL] = (72, 'B B I I 54B')
+        self.callback_formats[BrickletWARPEnergyManagerV2.CALLBACK_SD_DATA_POINTS_RANGE_COMPRESSED_LOW_LEVEL] = (72, 'B B I I B 53B')
 
         self.high_level_callbacks[BrickletWARPEnergyManagerV2.CALLBACK_SD_WALLBOX_DATA_POINTS] = [('stream_length', 'stream_chunk_offset', 'stream_chunk_data'), {'fixed_length': None, 'single_chunk': False}, None]
         self.high_level_callbacks[BrickletWARPEnergyManagerV2.CALLBACK_SD_WALLBOX_DAILY_DATA_POINTS] = [('stream_length', 'stream_chunk_offset', 'stream_chunk_data'), {'fixed_length': None, 'single_chunk': False}, None]
         self.high_level_callbacks[BrickletWARPEnergyManagerV2.CALLBACK_SD_ENERGY_MANAGER_DATA_POINTS] = [('stream_length', 'stream_chunk_offset', 'stream_chunk_data'), {'fixed_length': None, 'single_chunk': False}, None]
         self.high_level_callbacks[BrickletWARPEnergyManagerV2.CALLBACK_SD_ENERGY_MANAGER_DAILY_DATA_POINTS] = [('stream_length', 'stream_chunk_offset', 'stream_chunk_data'), {'fixed_length': None, 'single_chunk': False}, None]
+        self.high_level_callbacks[BrickletWARPEnergyManagerV2.CALLBACK_SD_DATA_POINTS_RANGE] = [(None, None, 'stream_length', 'stream_chunk_offset', 'stream_chunk_data'), {'fixed_length': None, 'single_chunk': False}, None]
         ipcon.add_device(self)
 
     def get_energy_meter_values(self):
@@ -474,6 +532,193 @@ class BrickletWARPEnergyManagerV2(Device):
 
         self.ipcon.send_request(self, BrickletWARPEnergyManagerV2.FUNCTION_RESET_ENERGY_METER_RELATIVE_ENERGY, (), '', 0, '')
 
+    def set_sd_wallbox_data_points_low_level(self, data_length, data_chunk_offset, data_chunk_data):
+        r"""
+        TODO
+        """
+        self.check_validity()
+
+        data_length = int(data_length)
+        data_chunk_offset = int(data_chunk_offset)
+        data_chunk_data = list(map(int, data_chunk_data))
+
+        return SetSDWallboxDataPointsLowLevel(*self.ipcon.send_request(self, BrickletWARPEnergyManagerV2.FUNCTION_SET_SD_WALLBOX_DATA_POINTS_LOW_LEVEL, (data_length, data_chunk_offset, data_chunk_data), 'H H 60B', 13, 'B H H'))
+
+    def set_sd_energy_manager_data_points_low_level(self, data_length, data_chunk_offset, data_chunk_data):
+        r"""
+        TODO
+        """
+        self.check_validity()
+
+        data_length = int(data_length)
+        data_chunk_offset = int(data_chunk_offset)
+        data_chunk_data = list(map(int, data_chunk_data))
+
+        return SetSDEnergyManagerDataPointsLowLevel(*self.ipcon.send_request(self, BrickletWARPEnergyManagerV2.FUNCTION_SET_SD_ENERGY_MANAGER_DATA_POINTS_LOW_LEVEL, (data_length, data_chunk_offset, data_chunk_data), 'H H 60B', 13, 'B H H'))
+
+    def get_sd_queue_status(self):
+        r"""
+        TODO
+        """
+        self.check_validity()
+
+        return GetSDQueueStatus(*self.ipcon.send_request(self, BrickletWARPEnergyManagerV2.FUNCTION_GET_SD_QUEUE_STATUS, (), '', 16, 'H H H H'))
+
+    def get_main_loop_latency(self):
+        r"""
+        TODO
+        """
+        self.check_validity()
+
+        return self.ipcon.send_request(self, BrickletWARPEnergyManagerV2.FUNCTION_GET_MAIN_LOOP_LATENCY, (), '', 12, 'I')
+
+    def get_sd_data_points_range(self, data_type, wallbox_id, start_year, start_month, start_day, start_hour, start_minute, end_year, end_month, end_day, end_hour, end_minute, compress):
+        r"""
+        TODO
+        """
+        self.check_validity()
+
+        data_type = int(data_type)
+        wallbox_id = int(wallbox_id)
+        start_year = int(start_year)
+        start_month = int(start_month)
+        start_day = int(start_day)
+        start_hour = int(start_hour)
+        start_minute = int(start_minute)
+        end_year = int(end_year)
+        end_month = int(end_month)
+        end_day = int(end_day)
+        end_hour = int(end_hour)
+        end_minute = int(end_minute)
+        compress = bool(compress)
+
+        return GetSDDataPointsRange(*self.ipcon.send_request(self, BrickletWARPEnergyManagerV2.FUNCTION_GET_SD_DATA_POINTS_RANGE, (data_type, wallbox_id, start_year, start_month, start_day, start_hour, start_minute, end_year, end_month, end_day, end_hour, end_minute, compress), 'B I B B B B B B B B B B !', 10, 'B B'))
+
+    def get_sd_energy_manager_data_points_aggregated(self, interval, start_year, start_month, start_day, start_hour, end_year, end_month, end_day, end_hour):
+        r"""
+        TODO
+        """
+        self.check_validity()
+
+        interval = int(interval)
+        start_year = int(start_year)
+        start_month = int(start_month)
+        start_day = int(start_day)
+        start_hour = int(start_hour)
+        end_year = int(end_year)
+        end_month = int(end_month)
+        end_day = int(end_day)
+        end_hour = int(end_hour)
+
+        return GetSDEnergyManagerDataPointsAggregated(*self.ipcon.send_request(self, BrickletWARPEnergyManagerV2.FUNCTION_GET_SD_ENERGY_MANAGER_DATA_POINTS_AGGREGATED, (interval, start_year, start_month, start_day, start_hour, end_year, end_month, end_day, end_hour), 'B B B B B B B B B', 10, 'B B'))
+
+    def get_sd_data_points_export(self, data_type, wallbox_id, cursor, end_year, end_month, end_day, compress):
+        r"""
+        TODO
+        """
+        self.check_validity()
+
+        data_type = int(data_type)
+        wallbox_id = int(wallbox_id)
+        cursor = int(cursor)
+        end_year = int(end_year)
+        end_month = int(end_month)
+        end_day = int(end_day)
+        compress = bool(compress)
+
+        return GetSDDataPointsExport(*self.ipcon.send_request(self, BrickletWARPEnergyManagerV2.FUNCTION_GET_SD_DATA_POINTS_EXPORT, (data_type, wallbox_id, cursor, end_year, end_month, end_day, compress), 'B I I B B B !', 14, 'B B I'))
+
+    def set_sd_wallbox_daily_data_points_low_level(self, data_length, data_chunk_offset, data_chunk_data):
+        r"""
+        TODO
+        """
+        self.check_validity()
+
+        data_length = int(data_length)
+        data_chunk_offset = int(data_chunk_offset)
+        data_chunk_data = list(map(int, data_chunk_data))
+
+        return SetSDWallboxDailyDataPointsLowLevel(*self.ipcon.send_request(self, BrickletWARPEnergyManagerV2.FUNCTION_SET_SD_WALLBOX_DAILY_DATA_POINTS_LOW_LEVEL, (data_length, data_chunk_offset, data_chunk_data), 'H H 60B', 13, 'B H H'))
+
+    def set_sd_energy_manager_daily_data_points_low_level(self, data_length, data_chunk_offset, data_chunk_data):
+        r"""
+        TODO
+        """
+        self.check_validity()
+
+        data_length = int(data_length)
+        data_chunk_offset = int(data_chunk_offset)
+        data_chunk_data = list(map(int, data_chunk_data))
+
+        return SetSDEnergyManagerDailyDataPointsLowLevel(*self.ipcon.send_request(self, BrickletWARPEnergyManagerV2.FUNCTION_SET_SD_ENERGY_MANAGER_DAILY_DATA_POINTS_LOW_LEVEL, (data_length, data_chunk_offset, data_chunk_data), 'H H 60B', 13, 'B H H'))
+
+    def set_data_storage_flush_delay(self, page, delay):
+        r"""
+        TODO
+        """
+        self.check_validity()
+
+        page = int(page)
+        delay = int(delay)
+
+        self.ipcon.send_request(self, BrickletWARPEnergyManagerV2.FUNCTION_SET_DATA_STORAGE_FLUSH_DELAY, (page, delay), 'B H', 0, '')
+
+    def get_data_storage_flush_delay(self, page):
+        r"""
+        TODO
+        """
+        self.check_validity()
+
+        page = int(page)
+
+        return self.ipcon.send_request(self, BrickletWARPEnergyManagerV2.FUNCTION_GET_DATA_STORAGE_FLUSH_DELAY, (page,), 'B', 10, 'H')
+
+    def flush_data_storage(self):
+        r"""
+        TODO
+        """
+        self.check_validity()
+
+        self.ipcon.send_request(self, BrickletWARPEnergyManagerV2.FUNCTION_FLUSH_DATA_STORAGE, (), '', 0, '')
+
+    def get_data_storage_status(self):
+        r"""
+        TODO
+        """
+        self.check_validity()
+
+        return self.ipcon.send_request(self, BrickletWARPEnergyManagerV2.FUNCTION_GET_DATA_STORAGE_STATUS, (), '', 10, 'H')
+
+    def get_data_storage_pages_low_level(self, pages_chunk_offset):
+        r"""
+        TODO
+        """
+        self.check_validity()
+
+        pages_chunk_offset = int(pages_chunk_offset)
+
+        return GetDataStoragePagesLowLevel(*self.ipcon.send_request(self, BrickletWARPEnergyManagerV2.FUNCTION_GET_DATA_STORAGE_PAGES_LOW_LEVEL, (pages_chunk_offset,), 'H', 72, 'H H 60B'))
+
+    def set_data_storage_pages_low_level(self, pages_length, pages_chunk_offset, pages_chunk_data):
+        r"""
+        TODO
+        """
+        self.check_validity()
+
+        pages_length = int(pages_length)
+        pages_chunk_offset = int(pages_chunk_offset)
+        pages_chunk_data = list(map(int, pages_chunk_data))
+
+        return SetDataStoragePagesLowLevel(*self.ipcon.send_request(self, BrickletWARPEnergyManagerV2.FUNCTION_SET_DATA_STORAGE_PAGES_LOW_LEVEL, (pages_length, pages_chunk_offset, pages_chunk_data), 'H H 60B', 11, 'B H'))
+
+    def get_sd_statistics(self):
+        r"""
+        TODO
+        """
+        self.check_validity()
+
+        return GetSDStatistics(*self.ipcon.send_request(self, BrickletWARPEnergyManagerV2.FUNCTION_GET_SD_STATISTICS, (), '', 68, 'I I I 8I 4H 4H'))
+
     def get_spitfp_error_count(self):
         r"""
         Returns the error count for the communication between Brick and Bricklet.
@@ -668,6 +913,49 @@ class BrickletWARPEnergyManagerV2(Device):
 
         return values_data[:values_length]
 
+    def get_data_storage_pages(self):
+        r"""
+        TODO
+        """
+        with self.stream_lock:
+            ret = self.get_data_storage_pages_low_level(0)
+            pages_length = ret.pages_length
+            pages_data = ret.pages_chunk_data
+
+            # Each chunk is requested by offset, there is no stream state to bring back in-sync
+            while len(pages_data) < pages_length:
+                ret = self.get_data_storage_pages_low_level(len(pages_data))
+
+                if ret.pages_chunk_offset != len(pages_data):
+                    raise Error(Error.STREAM_OUT_OF_SYNC, 'Pages stream is out-of-sync')
+
+                pages_data += ret.pages_chunk_data
+
+        return pages_data[:pages_length]
+
+    def set_data_storage_pages(self, pages):
+        r"""
+        TODO
+        """
+        pages = list(map(int, pages))
+        if len(pages) > 65535:
+            raise Error(Error.INVALID_PARAMETER, 'Pages can be at most 65535 items long')
+
+        pages_length = len(pages)
+        pages_chunk_offset = 0
+
+        with self.stream_lock:
+            if pages_length == 0:
+                pages_chunk_data = [0] * 60
+                ret = self.set_data_storage_pages_low_level(pages_length, pages_chunk_offset, pages_chunk_data)
+            else:
+                while pages_chunk_offset < pages_length:
+                    pages_chunk_data = create_chunk_data(pages, pages_chunk_offset, 60, 0)
+                    ret = self.set_data_storage_pages_low_level(pages_length, pages_chunk_offset, pages_chunk_data)
+                    pages_chunk_offset += 60
+
+        return ret
+
     def register_callback(self, callback_id, function):
         r"""
         Registers the given *function* with the given *callback_id*.
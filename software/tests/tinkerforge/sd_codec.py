@@ -0,0 +1,112 @@
+# -*- coding: utf-8 -*-
+
+# Decoder for the compressed SD data point streams of the
+# WARP Energy Manager 2.0 Bricklet (see get_sd_data_points_range).
+#
+# A stream consists of items: A varint with the number of repetitions of
+# the previous data point, followed by the next changed data point. Each
+# field of a data point is stored as zig-zag encoded difference to the
+# previous value as little endian base 128 varint.
+
+import struct
+
+# Field sizes per data type, same order as DATA_TYPE_*
+LAYOUTS = [
+    [2, 2],                                         # Wallbox: flags, power
+    [4],                                            # Wallbox daily: energy
+    [2, 4, 4, 4, 4, 4, 4, 4, 4],                    # Energy manager: flags, power_grid, power_general[6], price
+    [4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4],  # Energy manager daily
+]
+
+FIELD_FORMATS = {2: '<H', 4: '<I'}
+
+class SDCodecDecoder:
+    def __init__(self, data_type):
+        self.layout = LAYOUTS[data_type]
+        self.size = sum(self.layout)
+        self.reset()
+
+    def reset(self):
+        self.last = [0] * len(self.layout)
+        self.pending = b''
+        self.data = b''
+        self.offset = 0
+        self.in_sync = False
+
+    def _read_varint(self, data, pos):
+        value = 0
+        shift = 0
+        while True:
+            if pos >= len(data):
+                return None, pos
+            byte = data[pos]
+            pos += 1
+            value |= (byte & 0x7F) << shift
+            shift += 7
+            if byte & 0x80 == 0:
+                return value, pos
+
+    def _pack_last(self):
+        return b''.join(struct.pack(FIELD_FORMATS[size], value & ((1 << (size*8)) - 1)) for size, value in zip(self.layout, self.last))
+
+    def _decode_items(self, data_length):
+        pos = 0
+        while len(self.data) < data_length:
+            run, p = self._read_varint(self.pending, pos)
+            if run is None:
+                break
+            run_data = self._pack_last() * run
+
+            # The last item may only consist of the repetition count
+            if len(self.data) + len(run_data) >= data_length:
+                self.data += run_data
+                pos = p
+                break
+
+            values = []
+            for _ in self.layout:
+                zigzag, p = self._read_varint(self.pending, p)
+                if zigzag is None:
+                    break
+                values.append((zigzag >> 1) ^ -(zigzag & 1))
+
+            if len(values) < len(self.layout):
+                break
+
+            self.data += run_data
+            self.last = [(last + delta) & 0xFFFFFFFF for last, delta in zip(self.last, values)]
+            self.data += self._pack_last()
+            pos = p
+
+        self.pending = self.pending[pos:]
+
+    def feed(self, status, data_length, data_chunk_offset, data_chunk_length, data_chunk_data):
+        """
+        Feed one SD_DATA_POINTS_RANGE_COMPRESSED_LOW_LEVEL callback. Use one
+        decoder per request ID. Returns the uncompressed stream as bytes once
+        it is complete, otherwise None.
+
+        If the query was aborted (status is not DATA_STATUS_OK), the data
+        that was decoded so far is returned. It is shorter than data_length.
+        """
+        if status != 0:
+            in_sync = self.in_sync and data_chunk_offset == self.offset
+            self.in_sync = False
+            return self.data if in_sync else None
+
+        if data_chunk_offset == 0:
+            self.reset()
+            self.in_sync = True
+        elif not self.in_sync or data_chunk_offset != self.offset:
+            self.in_sync = False
+            return None
+
+        self.offset += data_chunk_length
+        self.pending += bytes(data_chunk_data[:data_chunk_length])
+        self._decode_items(data_length)
+
+        if len(self.data) >= data_length:
+            self.in_sync = False
+            return self.data[:data_length]
+
+        return None